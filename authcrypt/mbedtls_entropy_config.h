@@ -17,8 +17,14 @@
  *  This file is part of Mbed TLS (https://tls.mbed.org)
  */
 
+/*
+ * Mbed OS disables the platform entropy source (MBEDTLS_NO_PLATFORM_ENTROPY),
+ * whereas the host build uses the one of the operating system.
+ */
 #if !defined(MBEDTLS_ENTROPY_HARDWARE_ALT) && \
-    !defined(MBEDTLS_ENTROPY_NV_SEED) && !defined(MBEDTLS_TEST_NULL_ENTROPY)
+    !defined(MBEDTLS_ENTROPY_NV_SEED) && \
+    !defined(MBEDTLS_TEST_NULL_ENTROPY) && \
+    defined(MBEDTLS_NO_PLATFORM_ENTROPY)
 #error "This hardware does not have an entropy source."
 #endif /* !MBEDTLS_ENTROPY_HARDWARE_ALT && !MBEDTLS_ENTROPY_NV_SEED &&
-        * !MBEDTLS_TEST_NULL_ENTROPY */
+        * !MBEDTLS_TEST_NULL_ENTROPY && MBEDTLS_NO_PLATFORM_ENTROPY */
@@ -0,0 +1,242 @@
+/*
+ *  Heap and stack usage of the benchmarked primitives
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "mbed.h"
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif /* MBEDTLS_CONFIG_FILE */
+
+#include "mbedtls/platform.h"
+
+#include <stdint.h>
+
+#if defined(__MBED__) && defined(MBED_CONF_RTOS_PRESENT)
+#include "rtx_os.h"
+#endif /* __MBED__ && MBED_CONF_RTOS_PRESENT */
+
+#include "bench_memory.h"
+#include "bench_threads.h"
+
+/* Pattern written over the unused stack */
+#define STACK_PATTERN       0xA5
+/*
+ * Bytes left untouched below the frame of bench_memory_start(), which may
+ * still be in use by the function itself, such as the red zone of x86-64
+ */
+#define STACK_MARGIN        256
+/*
+ * Bytes left untouched above the bottom of the stack of a thread on Mbed OS,
+ * where RTX keeps the word that detects overflows
+ */
+#define STACK_GUARD         64
+/* Bytes painted on the host, where the stacks are much larger than needed */
+#define STACK_PAINT_SIZE    (128 * 1024)
+
+/*
+ * The stack is read and written below the stack pointer on purpose, which
+ * AddressSanitizer would report
+ */
+#if defined(__GNUC__)
+#define NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define NO_SANITIZE_ADDRESS
+#endif /* __GNUC__ */
+
+#if defined(MBEDTLS_PLATFORM_MEMORY)
+/* Size of each block, in front of it without changing its alignment */
+typedef union {
+    size_t size;
+    long double align_ld;
+    void *align_p;
+    uint64_t align_u64;
+} block_header_t;
+
+/*
+ * Heap usage of each thread: the blocks it allocated and has not freed, the
+ * highest usage and reference set by bench_memory_begin(), and the totals
+ * since bench_memory_start()
+ */
+static BENCH_THREAD_LOCAL size_t heap_used;
+static BENCH_THREAD_LOCAL size_t heap_peak;
+static BENCH_THREAD_LOCAL size_t heap_base;
+static BENCH_THREAD_LOCAL size_t heap_bytes;
+static BENCH_THREAD_LOCAL unsigned long heap_allocs;
+
+static void *counting_calloc(size_t n, size_t size)
+{
+    block_header_t *header;
+    size_t len;
+
+    if (n != 0 && size > (SIZE_MAX - sizeof(block_header_t)) / n) {
+        return NULL;
+    }
+    len = n * size;
+
+    header = (block_header_t *)calloc(1, sizeof(block_header_t) + len);
+    if (header == NULL) {
+        return NULL;
+    }
+    header->size = len;
+
+    heap_used += len;
+    if (heap_used > heap_peak) {
+        heap_peak = heap_used;
+    }
+    heap_bytes += len;
+    heap_allocs++;
+
+    return header + 1;
+}
+
+static void counting_free(void *p)
+{
+    block_header_t *header;
+
+    if (p == NULL) {
+        return;
+    }
+
+    header = (block_header_t *)p - 1;
+    /* A block freed by another thread than the one that allocated it */
+    heap_used = (header->size < heap_used) ? heap_used - header->size : 0;
+    free(header);
+}
+#endif /* MBEDTLS_PLATFORM_MEMORY */
+
+/*
+ * Stack painted by bench_memory_start() on each thread, from stack_bottom up
+ * to stack_top, and the address that the depth is measured from
+ */
+static BENCH_THREAD_LOCAL volatile unsigned char *stack_bottom;
+static BENCH_THREAD_LOCAL volatile unsigned char *stack_top;
+static BENCH_THREAD_LOCAL uintptr_t stack_frame;
+
+int bench_memory_init()
+{
+#if defined(MBEDTLS_PLATFORM_MEMORY)
+    if (mbedtls_platform_set_calloc_free(counting_calloc,
+                                         counting_free) != 0) {
+        mbedtls_printf("Failed to install the counting allocator\n");
+        return -1;
+    }
+#endif /* MBEDTLS_PLATFORM_MEMORY */
+
+    return 0;
+}
+
+int bench_memory_has_heap()
+{
+#if defined(MBEDTLS_PLATFORM_MEMORY)
+    return 1;
+#else
+    return 0;
+#endif /* MBEDTLS_PLATFORM_MEMORY */
+}
+
+int bench_memory_has_stack()
+{
+#if !defined(__MBED__) || defined(MBED_CONF_RTOS_PRESENT)
+    return 1;
+#else
+    return 0;
+#endif /* !__MBED__ || MBED_CONF_RTOS_PRESENT */
+}
+
+void bench_memory_begin()
+{
+#if defined(MBEDTLS_PLATFORM_MEMORY)
+    heap_base = heap_used;
+#endif /* MBEDTLS_PLATFORM_MEMORY */
+}
+
+/*
+ * Find the lowest address of the stack of the calling thread that can be
+ * painted, or return NULL if it is not known
+ */
+static volatile unsigned char *stack_limit(uintptr_t frame)
+{
+#if !defined(__MBED__)
+    return (volatile unsigned char *)(frame - STACK_MARGIN -
+                                      STACK_PAINT_SIZE);
+#elif defined(MBED_CONF_RTOS_PRESENT)
+    osRtxThread_t *thread = (osRtxThread_t *)osThreadGetId();
+
+    (void)frame;
+    if (thread == NULL || thread->stack_mem == NULL) {
+        return NULL;
+    }
+    return (volatile unsigned char *)thread->stack_mem + STACK_GUARD;
+#else
+    (void)frame;
+    return NULL;
+#endif /* !__MBED__ */
+}
+
+NO_SANITIZE_ADDRESS void bench_memory_start(bench_memory_t *m)
+{
+    unsigned char here;
+    volatile unsigned char *p;
+
+    memset(m, 0, sizeof(*m));
+
+#if defined(MBEDTLS_PLATFORM_MEMORY)
+    heap_peak = heap_used;
+    heap_bytes = 0;
+    heap_allocs = 0;
+#endif /* MBEDTLS_PLATFORM_MEMORY */
+
+    stack_frame = (uintptr_t)&here;
+    stack_top = (volatile unsigned char *)(stack_frame - STACK_MARGIN);
+    stack_bottom = stack_limit(stack_frame);
+    if (stack_bottom == NULL || stack_bottom >= stack_top) {
+        stack_bottom = NULL;
+        return;
+    }
+
+    for (p = stack_bottom; p < stack_top; p++) {
+        *p = STACK_PATTERN;
+    }
+}
+
+NO_SANITIZE_ADDRESS void bench_memory_stop(bench_memory_t *m)
+{
+    volatile unsigned char *p;
+
+#if defined(MBEDTLS_PLATFORM_MEMORY)
+    m->heap_peak = (heap_peak > heap_base) ? heap_peak - heap_base : 0;
+    m->heap_bytes = heap_bytes;
+    m->heap_allocs = heap_allocs;
+#endif /* MBEDTLS_PLATFORM_MEMORY */
+
+    if (stack_bottom == NULL) {
+        return;
+    }
+
+    /*
+     * The deepest byte that changed. A stack that overflowed the painted area
+     * shows as the whole area.
+     */
+    for (p = stack_bottom; p < stack_top && *p == STACK_PATTERN; p++) {
+    }
+    m->stack_peak = stack_frame - (uintptr_t)p;
+    stack_bottom = NULL;
+}
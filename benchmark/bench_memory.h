@@ -0,0 +1,93 @@
+/*
+ *  Heap and stack usage of the benchmarked primitives
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _BENCH_MEMORY_H_
+#define _BENCH_MEMORY_H_
+
+#include <stddef.h>
+
+/**
+ * Memory used by the calling thread between bench_memory_start() and
+ * bench_memory_stop().
+ *
+ * The heap is tracked by a counting allocator installed with
+ * mbedtls_platform_set_calloc_free(), so only the allocations made through
+ * mbedtls_calloc() are seen. The stack is painted with a pattern below the
+ * caller of bench_memory_start(), and the deepest byte that no longer holds
+ * the pattern gives the peak usage.
+ */
+typedef struct {
+    size_t heap_peak;           /**< Highest heap usage since
+                                     bench_memory_begin(), in bytes */
+    size_t heap_bytes;          /**< Total bytes allocated */
+    unsigned long heap_allocs;  /**< Number of allocations */
+    size_t stack_peak;          /**< Deepest stack usage, in bytes */
+} bench_memory_t;
+
+/**
+ * Install the counting allocator. Call this before anything is allocated
+ * with mbedtls_calloc(), since the blocks of another allocator cannot be
+ * freed by this one.
+ *
+ * \return  0 if successful, -1 if the allocator could not be installed
+ */
+int bench_memory_init(void);
+
+/**
+ * Check whether the heap usage is measured. This needs
+ * MBEDTLS_PLATFORM_MEMORY.
+ *
+ * \return  1 if the heap usage is measured, 0 otherwise
+ */
+int bench_memory_has_heap(void);
+
+/**
+ * Check whether the stack usage is measured. On Mbed OS this needs the RTOS,
+ * which gives the bounds of the stack of the thread.
+ *
+ * \return  1 if the stack usage is measured, 0 otherwise
+ */
+int bench_memory_has_stack(void);
+
+/**
+ * Take the current heap usage of the calling thread as the reference of the
+ * heap peaks, so that they only count the memory allocated from then on, for
+ * instance by the contexts of a benchmark and not by its buffers.
+ */
+void bench_memory_begin(void);
+
+/**
+ * Start measuring the memory used by the calling thread
+ *
+ * \param[out]  m
+ *              The measurement
+ */
+void bench_memory_start(bench_memory_t *m);
+
+/**
+ * Stop measuring the memory used by the calling thread. This must be called
+ * from the same function as bench_memory_start(), so that the stack depth is
+ * measured from the same frame.
+ *
+ * \param[in,out]   m
+ *                  The measurement
+ */
+void bench_memory_stop(bench_memory_t *m);
+
+#endif /* _BENCH_MEMORY_H_ */
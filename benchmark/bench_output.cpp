@@ -0,0 +1,515 @@
+/*
+ *  Structured output and baseline comparison for the benchmark
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "mbed.h"
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif /* MBEDTLS_CONFIG_FILE */
+
+#include "mbedtls/platform.h"
+
+#include "bench_output.h"
+#include "bench_threads.h"
+
+enum {
+    FORMAT_HUMAN,
+    FORMAT_CSV,
+    FORMAT_JSON,
+};
+
+static int format = FORMAT_HUMAN;
+
+int bench_output_set_format(const char *name)
+{
+    if (strcmp(name, "human") == 0) {
+        format = FORMAT_HUMAN;
+    } else if (strcmp(name, "csv") == 0) {
+        format = FORMAT_CSV;
+    } else if (strcmp(name, "json") == 0) {
+        format = FORMAT_JSON;
+    } else {
+        mbedtls_printf("Unknown output format \"%s\"\n", name);
+        return -1;
+    }
+
+    return 0;
+}
+
+int bench_output_human()
+{
+    return format == FORMAT_HUMAN;
+}
+
+/*
+ * Stream of the lines that are not records. In the structured formats they
+ * go to stderr on the host, so that stdout only holds the records.
+ */
+static FILE *notes()
+{
+#if !defined(__MBED__)
+    if (format != FORMAT_HUMAN) {
+        return stderr;
+    }
+#endif /* !__MBED__ */
+    return stdout;
+}
+
+void bench_output_done()
+{
+    fprintf(notes(), "DONE\n");
+}
+
+void bench_output_begin()
+{
+    if (format == FORMAT_CSV) {
+        mbedtls_printf("algorithm,operation,key_bits,buffer_bytes,threads,"
+                       "metric,unit,value\n");
+    }
+}
+
+/*
+ * Print a value with three decimals without relying on floating point or
+ * long long support in printf, which are often left out of embedded C
+ * libraries. unsigned long is 32 bits wide on the boards, so the integer
+ * part is printed in groups of nine digits to go above 4 GiB.
+ */
+static void print_value(double value)
+{
+    uint64_t integer;
+    unsigned long fraction;
+
+    if (value < 0) {
+        mbedtls_printf("-");
+        value = -value;
+    }
+
+    integer = static_cast<uint64_t>(value);
+    fraction = static_cast<unsigned long>((value - integer) * 1000 + 0.5);
+    if (fraction >= 1000) {
+        integer++;
+        fraction -= 1000;
+    }
+
+    if (integer >= 1000000000) {
+        mbedtls_printf("%lu%09lu",
+                       static_cast<unsigned long>(integer / 1000000000),
+                       static_cast<unsigned long>(integer % 1000000000));
+    } else {
+        mbedtls_printf("%lu", static_cast<unsigned long>(integer));
+    }
+    mbedtls_printf(".%03lu", fraction);
+}
+
+/*
+ * Print a CSV field, quoted as in RFC 4180 if it contains a separator or a
+ * quote
+ */
+static void print_csv_field(const char *s)
+{
+    if (strpbrk(s, ",\"\r\n") == NULL) {
+        mbedtls_printf("%s", s);
+        return;
+    }
+
+    mbedtls_printf("\"");
+    for (; *s != '\0'; s++) {
+        if (*s == '"') {
+            mbedtls_printf("\"");
+        }
+        mbedtls_printf("%c", *s);
+    }
+    mbedtls_printf("\"");
+}
+
+static void print_json_string(const char *s)
+{
+    mbedtls_printf("\"");
+    for (; *s != '\0'; s++) {
+        if (*s == '"' || *s == '\\') {
+            mbedtls_printf("\\");
+        }
+        mbedtls_printf("%c", *s);
+    }
+    mbedtls_printf("\"");
+}
+
+static void print_record(const char *algorithm, const char *operation,
+                         unsigned long key_bits, size_t buffer_len,
+                         unsigned long threads, const char *metric,
+                         const char *unit, double value)
+{
+    if (format == FORMAT_CSV) {
+        print_csv_field(algorithm);
+        mbedtls_printf(",");
+        print_csv_field(operation);
+        mbedtls_printf(",%lu,%lu,%lu,", key_bits,
+                       static_cast<unsigned long>(buffer_len), threads);
+        print_csv_field(metric);
+        mbedtls_printf(",");
+        print_csv_field(unit);
+        mbedtls_printf(",");
+        print_value(value);
+        mbedtls_printf("\n");
+    } else if (format == FORMAT_JSON) {
+        mbedtls_printf("{\"algorithm\":");
+        print_json_string(algorithm);
+        mbedtls_printf(",\"operation\":");
+        print_json_string(operation);
+        mbedtls_printf(",\"key_bits\":%lu,\"buffer_bytes\":%lu,"
+                       "\"threads\":%lu,\"metric\":", key_bits,
+                       static_cast<unsigned long>(buffer_len), threads);
+        print_json_string(metric);
+        mbedtls_printf(",\"unit\":");
+        print_json_string(unit);
+        mbedtls_printf(",\"value\":");
+        print_value(value);
+        mbedtls_printf("}\n");
+    }
+}
+
+#if !defined(__MBED__)
+#define RECORD_NAME_LEN     32
+
+/* A record of the baseline, or of a results file being compared */
+typedef struct {
+    char algorithm[RECORD_NAME_LEN];
+    char operation[RECORD_NAME_LEN];
+    unsigned long key_bits;
+    unsigned long buffer_len;
+    unsigned long threads;
+    char metric[RECORD_NAME_LEN];
+    char unit[RECORD_NAME_LEN];
+    double value;
+} record_t;
+
+static record_t *baseline;
+static size_t baseline_count;
+static double tolerance = 5.0;
+
+static unsigned long compared;
+static unsigned long regressions;
+static unsigned long improvements;
+
+static int copy_field(char *dst, const char *src, size_t len)
+{
+    if (len >= RECORD_NAME_LEN) {
+        return -1;
+    }
+
+    memcpy(dst, src, len);
+    dst[len] = '\0';
+    return 0;
+}
+
+/*
+ * Copy the CSV field at *p, unquoted, into dst of RECORD_NAME_LEN bytes and
+ * move *p to the start of the next field. last tells whether the field must
+ * end the line or be followed by a comma.
+ */
+static int next_field(const char **p, char *dst, int last)
+{
+    const char *s = *p;
+    size_t len = 0;
+
+    if (*s == '"') {
+        for (s++; *s != '"' || s[1] == '"'; s++) {
+            if (*s == '\0' || len == RECORD_NAME_LEN - 1) {
+                return -1;
+            }
+            if (*s == '"') {
+                s++;
+            }
+            dst[len++] = *s;
+        }
+        s++;
+    } else {
+        while (*s != ',' && *s != '\0' && *s != '\r' && *s != '\n') {
+            if (*s == '"' || len == RECORD_NAME_LEN - 1) {
+                return -1;
+            }
+            dst[len++] = *s++;
+        }
+    }
+    dst[len] = '\0';
+
+    if (last) {
+        if (*s != '\0' && *s != '\r' && *s != '\n') {
+            return -1;
+        }
+    } else if (*s++ != ',') {
+        return -1;
+    }
+
+    *p = s;
+    return 0;
+}
+
+/*
+ * Parse an unsigned decimal CSV field
+ */
+static int parse_number(const char *field, unsigned long *value)
+{
+    char *end;
+
+    if (*field < '0' || *field > '9') {
+        return -1;
+    }
+    *value = strtoul(field, &end, 10);
+    return (*end == '\0') ? 0 : -1;
+}
+
+/*
+ * Parse a CSV record as printed by print_record(). Return -1 for any other
+ * line, such as the header or the text printed around the records.
+ */
+static int parse_record(const char *line, record_t *rec)
+{
+    const char *p = line;
+    char key_bits[RECORD_NAME_LEN], buffer_len[RECORD_NAME_LEN];
+    char threads[RECORD_NAME_LEN], value[RECORD_NAME_LEN];
+    char *end;
+
+    if (next_field(&p, rec->algorithm, 0) != 0 ||
+            next_field(&p, rec->operation, 0) != 0 ||
+            next_field(&p, key_bits, 0) != 0 ||
+            next_field(&p, buffer_len, 0) != 0 ||
+            next_field(&p, threads, 0) != 0 ||
+            next_field(&p, rec->metric, 0) != 0 ||
+            next_field(&p, rec->unit, 0) != 0 ||
+            next_field(&p, value, 1) != 0) {
+        return -1;
+    }
+
+    if (parse_number(key_bits, &rec->key_bits) != 0 ||
+            parse_number(buffer_len, &rec->buffer_len) != 0 ||
+            parse_number(threads, &rec->threads) != 0) {
+        return -1;
+    }
+    rec->value = strtod(value, &end);
+    if (end == value || *end != '\0') {
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * Call f for each CSV record in a file, stopping at the first error
+ */
+static int read_records(const char *path, int (*f)(const record_t *rec))
+{
+    FILE *file;
+    char line[256];
+    record_t rec;
+    int ret = 0;
+
+    file = fopen(path, "r");
+    if (file == NULL) {
+        mbedtls_printf("Failed to open %s\n", path);
+        return -1;
+    }
+
+    while (ret == 0 && fgets(line, sizeof(line), file) != NULL) {
+        if (parse_record(line, &rec) == 0) {
+            ret = f(&rec);
+        }
+    }
+
+    fclose(file);
+    return ret;
+}
+
+static int add_baseline(const record_t *rec)
+{
+    record_t *grown;
+
+    grown = (record_t *)realloc(baseline,
+                                (baseline_count + 1) * sizeof(record_t));
+    if (grown == NULL) {
+        mbedtls_printf("Failed to allocate the baseline\n");
+        return -1;
+    }
+
+    baseline = grown;
+    baseline[baseline_count++] = *rec;
+    return 0;
+}
+
+int bench_output_load_baseline(const char *path)
+{
+    if (read_records(path, add_baseline) != 0) {
+        return -1;
+    }
+
+    if (baseline_count == 0) {
+        mbedtls_printf("No CSV records in %s\n", path);
+        return -1;
+    }
+
+    return 0;
+}
+
+void bench_output_set_tolerance(double percent)
+{
+    tolerance = percent;
+}
+
+static const record_t *find_baseline(const record_t *rec)
+{
+    size_t i;
+
+    for (i = 0; i < baseline_count; i++) {
+        if (strcmp(baseline[i].algorithm, rec->algorithm) == 0 &&
+                strcmp(baseline[i].operation, rec->operation) == 0 &&
+                baseline[i].key_bits == rec->key_bits &&
+                baseline[i].buffer_len == rec->buffer_len &&
+                baseline[i].threads == rec->threads &&
+                strcmp(baseline[i].metric, rec->metric) == 0) {
+            return &baseline[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Compare a throughput or a rate (higher is better) or a latency (lower is
+ * better) with the baseline. With standalone set, the comparison is not
+ * printed under the result it refers to, so it names the result.
+ */
+static int compare(const record_t *rec, int standalone)
+{
+    const record_t *base;
+    double change;
+    int worse, better;
+    char what[RECORD_NAME_LEN + 8];
+
+    if (strcmp(rec->metric, "throughput") != 0 &&
+            strcmp(rec->metric, "rate") != 0 &&
+            strcmp(rec->metric, "latency") != 0) {
+        return 0;
+    }
+
+    base = find_baseline(rec);
+    if (base == NULL || base->value == 0) {
+        return 0;
+    }
+
+    change = (rec->value - base->value) * 100 / base->value;
+    if (strcmp(rec->metric, "latency") != 0) {
+        worse = change < -tolerance;
+        better = change > tolerance;
+    } else {
+        worse = change > tolerance;
+        better = change < -tolerance;
+    }
+
+    compared++;
+    regressions += worse;
+    improvements += better;
+
+    if (format != FORMAT_HUMAN) {
+        print_record(rec->algorithm, rec->operation, rec->key_bits,
+                     rec->buffer_len, rec->threads, "change", "%", change);
+        return 0;
+    }
+
+    if (standalone) {
+        if (rec->operation[0] != '\0') {
+            snprintf(what, sizeof(what), "%s", rec->operation);
+        } else {
+            snprintf(what, sizeof(what), "%lu B", rec->buffer_len);
+        }
+        mbedtls_printf("  %-24s %10s", rec->algorithm, what);
+        if (rec->threads > 1) {
+            mbedtls_printf(" %3lu threads", rec->threads);
+        }
+        mbedtls_printf(" : ");
+    } else {
+        mbedtls_printf("  %24s    ", "");
+    }
+    mbedtls_printf("change: %+.2f%% vs baseline%s\n", change,
+                   worse ? ", regression" : better ? ", improvement" : "");
+
+    return 0;
+}
+
+static int compare_standalone(const record_t *rec)
+{
+    return compare(rec, 1);
+}
+
+int bench_output_compare_file(const char *path)
+{
+    return read_records(path, compare_standalone);
+}
+#endif /* !__MBED__ */
+
+void bench_output_record(const char *algorithm, const char *operation,
+                         unsigned long key_bits, size_t buffer_len,
+                         const char *metric, const char *unit, double value)
+{
+    /* Drop the indentation that aligns some names in the human format */
+    algorithm += strspn(algorithm, " ");
+    operation += strspn(operation, " ");
+
+    print_record(algorithm, operation, key_bits, buffer_len,
+                 bench_threads_count(), metric, unit, value);
+
+#if !defined(__MBED__)
+    if (baseline != NULL) {
+        record_t rec;
+
+        if (copy_field(rec.algorithm, algorithm, strlen(algorithm)) != 0 ||
+                copy_field(rec.operation, operation, strlen(operation)) != 0 ||
+                copy_field(rec.metric, metric, strlen(metric)) != 0 ||
+                copy_field(rec.unit, unit, strlen(unit)) != 0) {
+            return;
+        }
+        rec.key_bits = key_bits;
+        rec.buffer_len = buffer_len;
+        rec.threads = bench_threads_count();
+        rec.value = value;
+
+        compare(&rec, 0);
+    }
+#endif /* !__MBED__ */
+}
+
+unsigned long bench_output_end()
+{
+#if !defined(__MBED__)
+    if (baseline != NULL) {
+        fprintf(notes(), "Compared %lu results with the baseline: %lu "
+                "regressions and %lu improvements outside the tolerance of "
+                "%.2f%%\n", compared, regressions, improvements, tolerance);
+    }
+
+    free(baseline);
+    baseline = NULL;
+    baseline_count = 0;
+
+    return regressions;
+#else
+    return 0;
+#endif /* !__MBED__ */
+}
@@ -0,0 +1,127 @@
+/*
+ *  Structured output and baseline comparison for the benchmark
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _BENCH_OUTPUT_H_
+#define _BENCH_OUTPUT_H_
+
+#include <stddef.h>
+
+/**
+ * Select the output format
+ *
+ * In the "human" format the benchmark prints aligned lines and records are
+ * not printed. In the "csv" and "json" formats every measured value is
+ * printed as a record: a CSV line with the columns
+ * algorithm,operation,key_bits,buffer_bytes,threads,metric,unit,value, or a
+ * JSON object with the same keys on a line of its own.
+ *
+ * \param[in]   name
+ *              "human", "csv" or "json"
+ *
+ * \return  0 if successful, -1 if the format is unknown
+ */
+int bench_output_set_format(const char *name);
+
+/**
+ * Check whether the benchmark should print its human readable lines
+ *
+ * \return  1 in the human format, 0 otherwise
+ */
+int bench_output_human(void);
+
+/**
+ * Print the CSV header, if needed. Call this before the first record.
+ */
+void bench_output_begin(void);
+
+/**
+ * Print a measured value and compare it with the baseline, if any. The value
+ * is recorded with the number of threads of the current run.
+ *
+ * \param[in]   algorithm
+ *              Name of the primitive, as in the human readable output
+ * \param[in]   operation
+ *              Operation of a public key primitive such as "sign", or an
+ *              empty string
+ * \param[in]   key_bits
+ *              Key size in bits, or 0 if the primitive has no key
+ * \param[in]   buffer_len
+ *              Bytes processed per call, or 0 for the public key primitives
+ * \param[in]   metric
+ *              What the value measures: "throughput", "latency", "rate",
+ *              "time", "cycles", "efficiency", a statistic of the samples
+ *              such as "p99", or a memory usage such as "heap_peak"
+ * \param[in]   unit
+ *              Unit of the value, such as "KB/s" or "ms"
+ * \param[in]   value
+ *              The value
+ */
+void bench_output_record(const char *algorithm, const char *operation,
+                         unsigned long key_bits, size_t buffer_len,
+                         const char *metric, const char *unit, double value);
+
+/**
+ * Print the summary of the comparison with the baseline, if any. In the
+ * "csv" and "json" formats it goes to stderr on the host, after the records.
+ *
+ * \return  The number of regressions outside the tolerance
+ */
+unsigned long bench_output_end(void);
+
+/**
+ * Print the line that ends the output of the benchmark, on stderr in the
+ * "csv" and "json" formats on the host
+ */
+void bench_output_done(void);
+
+#if !defined(__MBED__)
+/**
+ * Load the CSV records of a previous run to compare the results with. The
+ * "throughput", "latency" and "rate" metrics are compared; lines that are
+ * not records are ignored, so a captured serial log can be used directly.
+ *
+ * \param[in]   path
+ *              The baseline file
+ *
+ * \return  0 if successful, -1 otherwise
+ */
+int bench_output_load_baseline(const char *path);
+
+/**
+ * Set the change, in percent, above which a result is reported as outside
+ * the tolerance. The default is 5%.
+ *
+ * \param[in]   percent
+ *              The tolerance
+ */
+void bench_output_set_tolerance(double percent);
+
+/**
+ * Compare the CSV records of a results file with the baseline instead of
+ * running the benchmark, for instance to check the log of a board
+ *
+ * \param[in]   path
+ *              The results file
+ *
+ * \return  0 if successful, -1 if the file could not be read
+ */
+int bench_output_compare_file(const char *path);
+#endif /* !__MBED__ */
+
+#endif /* _BENCH_OUTPUT_H_ */
@@ -0,0 +1,192 @@
+/*
+ *  Hardware performance counters of the benchmark
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "mbed.h"
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif /* MBEDTLS_CONFIG_FILE */
+
+#include "mbedtls/platform.h"
+
+#include <string.h>
+
+#include "bench_perf.h"
+#include "bench_threads.h"
+
+#if !defined(__MBED__) && defined(__linux__)
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#define BENCH_PERF_LINUX
+#endif /* !__MBED__ && __linux__ */
+
+#if defined(BENCH_PERF_LINUX)
+/* Type and configuration of each event, in the order of bench_perf_t */
+static const struct {
+    uint32_t type;
+    uint64_t config;
+    const char *name;
+} events[BENCH_PERF_EVENTS] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles" },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions" },
+    {
+        PERF_TYPE_HW_CACHE,
+        PERF_COUNT_HW_CACHE_L1D |
+        (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        "L1 data cache read misses"
+    },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, "LLC misses" },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch misses" },
+};
+
+/* File descriptor of each event, or -1 if it is not counted */
+static int fds[BENCH_PERF_EVENTS] = { -1, -1, -1, -1, -1 };
+
+/* Layout of a read with PERF_FORMAT_TOTAL_TIME_ENABLED and _RUNNING */
+typedef struct {
+    uint64_t value;
+    uint64_t time_enabled;
+    uint64_t time_running;
+} perf_read_t;
+#endif /* BENCH_PERF_LINUX */
+
+static int enabled;
+
+int bench_perf_init()
+{
+#if defined(BENCH_PERF_LINUX)
+    struct perf_event_attr attr;
+    int i;
+
+    for (i = 0; i < BENCH_PERF_EVENTS; i++) {
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = events[i].type;
+        attr.config = events[i].config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        /* The calling thread, on any CPU */
+        fds[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if (fds[i] < 0) {
+            mbedtls_printf("Cannot count the %s: %s\n", events[i].name,
+                           strerror(errno));
+            continue;
+        }
+        enabled = 1;
+    }
+
+    if (!enabled) {
+        mbedtls_printf("No hardware counter is available; see "
+                       "/proc/sys/kernel/perf_event_paranoid\n");
+        return -1;
+    }
+
+    return 0;
+#else
+    mbedtls_printf("Hardware counters are only available on Linux\n");
+    return -1;
+#endif /* BENCH_PERF_LINUX */
+}
+
+int bench_perf_enabled()
+{
+    return enabled;
+}
+
+void bench_perf_start(bench_perf_t *p)
+{
+#if defined(BENCH_PERF_LINUX)
+    int i;
+#endif /* BENCH_PERF_LINUX */
+
+    memset(p, 0, sizeof(*p));
+    if (!enabled || bench_threads_id() != 0) {
+        return;
+    }
+
+#if defined(BENCH_PERF_LINUX)
+    for (i = 0; i < BENCH_PERF_EVENTS; i++) {
+        if (fds[i] >= 0) {
+            ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif /* BENCH_PERF_LINUX */
+}
+
+void bench_perf_stop(bench_perf_t *p)
+{
+#if defined(BENCH_PERF_LINUX)
+    perf_read_t r;
+    int i;
+
+    if (!enabled || bench_threads_id() != 0) {
+        return;
+    }
+
+    for (i = 0; i < BENCH_PERF_EVENTS; i++) {
+        if (fds[i] >= 0) {
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    for (i = 0; i < BENCH_PERF_EVENTS; i++) {
+        if (fds[i] < 0 || read(fds[i], &r, sizeof(r)) != sizeof(r) ||
+                r.time_running == 0) {
+            continue;
+        }
+
+        /* The event shared a counter with others for part of the run */
+        if (r.time_running < r.time_enabled) {
+            r.value = (uint64_t)((double)r.value * r.time_enabled /
+                                 r.time_running);
+        }
+        p->counts[i] = r.value;
+        p->valid[i] = 1;
+    }
+#else
+    (void)p;
+#endif /* BENCH_PERF_LINUX */
+}
+
+void bench_perf_free()
+{
+#if defined(BENCH_PERF_LINUX)
+    int i;
+
+    for (i = 0; i < BENCH_PERF_EVENTS; i++) {
+        if (fds[i] >= 0) {
+            close(fds[i]);
+            fds[i] = -1;
+        }
+    }
+#endif /* BENCH_PERF_LINUX */
+
+    enabled = 0;
+}
@@ -0,0 +1,85 @@
+/*
+ *  Hardware performance counters of the benchmark
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _BENCH_PERF_H_
+#define _BENCH_PERF_H_
+
+#include <stdint.h>
+
+/* Events counted, in the order of bench_perf_t.counts */
+#define BENCH_PERF_CYCLES           0
+#define BENCH_PERF_INSTRUCTIONS     1
+#define BENCH_PERF_L1D_MISSES       2
+#define BENCH_PERF_LLC_MISSES       3
+#define BENCH_PERF_BRANCH_MISSES    4
+#define BENCH_PERF_EVENTS           5
+
+/**
+ * Events counted by the hardware between bench_perf_start() and
+ * bench_perf_stop() on the thread that called bench_perf_init().
+ *
+ * The counters are read with perf_event_open() on a Linux host, in user
+ * space only. When the kernel multiplexes more events than the core has
+ * counters, the counts are scaled by the time that each event was counted.
+ * The L1 data cache misses are read misses. No counter is available on Mbed
+ * OS, where the cycles are already read from DWT CYCCNT.
+ */
+typedef struct {
+    uint64_t counts[BENCH_PERF_EVENTS];     /**< Count of each event */
+    int valid[BENCH_PERF_EVENTS];           /**< The event was counted */
+} bench_perf_t;
+
+/**
+ * Open the counters for the calling thread. The events that the kernel or
+ * the core does not support are left out.
+ *
+ * \return  0 if at least one event is counted, -1 otherwise
+ */
+int bench_perf_init(void);
+
+/**
+ * Check whether the counters are open
+ *
+ * \return  1 if at least one event is counted, 0 otherwise
+ */
+int bench_perf_enabled(void);
+
+/**
+ * Start counting. This does nothing on other threads than the one that
+ * called bench_perf_init().
+ *
+ * \param[out]  p
+ *              The counts
+ */
+void bench_perf_start(bench_perf_t *p);
+
+/**
+ * Stop counting and read the counts
+ *
+ * \param[in,out]   p
+ *                  The counts
+ */
+void bench_perf_stop(bench_perf_t *p);
+
+/**
+ * Close the counters
+ */
+void bench_perf_free(void);
+
+#endif /* _BENCH_PERF_H_ */
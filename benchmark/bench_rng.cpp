@@ -0,0 +1,134 @@
+/*
+ *  Deterministic random generator of the benchmark
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "mbed.h"
+
+#include <string.h>
+
+#include "bench_rng.h"
+#include "bench_threads.h"
+#include "bench_timing.h"
+
+/* State of the xoshiro128** generator of each thread */
+static BENCH_THREAD_LOCAL uint32_t state[4];
+/*
+ * Bytes consumed since bench_rng_start(), and the time spent in the calls if
+ * they are timed
+ */
+static BENCH_THREAD_LOCAL bench_rng_usage_t usage;
+static BENCH_THREAD_LOCAL bench_measure_t rng_m;
+static int timed;
+
+static inline uint32_t rotl(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+static uint32_t next()
+{
+    uint32_t result = rotl(state[1] * 5, 7) * 9;
+    uint32_t t = state[1] << 9;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 11);
+
+    return result;
+}
+
+/*
+ * Expand the seed with splitmix64, as recommended by the authors of
+ * xoshiro, so that close seeds give unrelated streams and the state is never
+ * all zero
+ */
+void bench_rng_seed(unsigned long seed, unsigned long stream)
+{
+    uint64_t x = (static_cast<uint64_t>(seed) << 32) ^ stream;
+    uint64_t z;
+    int i;
+
+    for (i = 0; i < 2; i++) {
+        x += 0x9E3779B97F4A7C15ULL;
+        z = x;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        state[2 * i] = static_cast<uint32_t>(z);
+        state[2 * i + 1] = static_cast<uint32_t>(z >> 32);
+    }
+}
+
+void bench_rng_set_timed(int t)
+{
+    timed = t;
+}
+
+int bench_rng_timed()
+{
+    return timed;
+}
+
+int bench_rng(void *p_rng, unsigned char *output, size_t len)
+{
+    uint32_t r;
+
+    (void)p_rng;
+
+    if (timed) {
+        bench_timing_start(&rng_m);
+    }
+
+    usage.calls++;
+    usage.bytes += len;
+
+    while (len >= sizeof(r)) {
+        r = next();
+        memcpy(output, &r, sizeof(r));
+        output += sizeof(r);
+        len -= sizeof(r);
+    }
+    if (len > 0) {
+        r = next();
+        memcpy(output, &r, len);
+    }
+
+    if (timed) {
+        bench_timing_stop(&rng_m, 1);
+    }
+
+    return 0;
+}
+
+void bench_rng_start()
+{
+    memset(&usage, 0, sizeof(usage));
+    bench_timing_reset(&rng_m);
+}
+
+void bench_rng_usage(bench_rng_usage_t *u)
+{
+    *u = usage;
+    if (rng_m.iterations > 0) {
+        u->ns = static_cast<uint64_t>(bench_timing_ns_per_op(&rng_m) *
+                                      rng_m.iterations);
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ *  Deterministic random generator of the benchmark
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _BENCH_RNG_H_
+#define _BENCH_RNG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Random bytes consumed by the calling thread since bench_rng_start().
+ *
+ * The generator is xoshiro128**, which costs a few cycles per 4 bytes and
+ * takes no lock, so that the primitives that need random bytes are timed
+ * rather than the generator. It is NOT suitable for anything but benchmarks.
+ * Each thread has its own state, seeded by bench_rng_seed(), so a benchmark
+ * sees the same bytes on every run with the same seed.
+ */
+typedef struct {
+    unsigned long calls;        /**< Number of calls of bench_rng() */
+    uint64_t bytes;             /**< Total bytes generated */
+    uint64_t ns;                /**< Time spent in bench_rng(), without the
+                                     calibrated cost of reading the clock,
+                                     if bench_rng_set_timed() */
+} bench_rng_usage_t;
+
+/**
+ * Seed the generator of the calling thread. The threads of a run use
+ * different streams derived from the same seed.
+ *
+ * \param[in]   seed
+ *              The seed
+ * \param[in]   stream
+ *              Number of the stream, such as the identifier of the thread
+ */
+void bench_rng_seed(unsigned long seed, unsigned long stream);
+
+/**
+ * Choose whether the calls of bench_rng() are timed. Reading the clock in
+ * every call adds its own cost to the primitive being benchmarked, so this
+ * is only meant to show the share of the generator in a result.
+ *
+ * \param[in]   timed
+ *              1 to time the calls, 0 otherwise
+ */
+void bench_rng_set_timed(int timed);
+
+/**
+ * Check whether the calls of bench_rng() are timed
+ *
+ * \return  1 if the calls are timed, 0 otherwise
+ */
+int bench_rng_timed(void);
+
+/**
+ * Generate random bytes from the generator of the calling thread. This has
+ * the prototype of the f_rng callbacks of Mbed TLS.
+ *
+ * \param[in]   p_rng
+ *              Unused, the state is per thread
+ * \param[out]  output
+ *              Buffer to fill
+ * \param[in]   len
+ *              Number of bytes to generate
+ *
+ * \return  0
+ */
+int bench_rng(void *p_rng, unsigned char *output, size_t len);
+
+/**
+ * Start counting the bytes consumed by the calling thread
+ */
+void bench_rng_start(void);
+
+/**
+ * Get the bytes consumed by the calling thread since bench_rng_start()
+ *
+ * \param[out]  u
+ *              The usage
+ */
+void bench_rng_usage(bench_rng_usage_t *u);
+
+#endif /* _BENCH_RNG_H_ */
@@ -0,0 +1,229 @@
+/*
+ *  Repetitions and statistics for the benchmark
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "mbed.h"
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif /* MBEDTLS_CONFIG_FILE */
+
+#include "mbedtls/platform.h"
+
+#include <math.h>
+
+#include "bench_runner.h"
+#include "bench_threads.h"
+
+enum {
+    PHASE_WARMUP,
+    PHASE_GROW,
+    PHASE_SAMPLE,
+    PHASE_DONE,
+};
+
+static unsigned long warmup_iterations;
+static unsigned long repetitions = 1;
+/* Time of one iteration in each sample of the current run of each thread */
+static BENCH_THREAD_LOCAL double *samples;
+static BENCH_THREAD_LOCAL unsigned long samples_size;
+
+/* Make room for n samples, keeping no samples if they cannot be allocated */
+static int reserve_samples(unsigned long n)
+{
+    if (n <= samples_size) {
+        return 0;
+    }
+
+    bench_runner_free();
+    samples = (double *)mbedtls_calloc(n, sizeof(double));
+    if (samples == NULL) {
+        return -1;
+    }
+    samples_size = n;
+
+    return 0;
+}
+
+int bench_runner_init(unsigned long warmup, unsigned long reps)
+{
+    warmup_iterations = warmup;
+    repetitions = (reps > 0) ? reps : 1;
+
+    if (repetitions > 1) {
+        return reserve_samples(repetitions);
+    }
+
+    return 0;
+}
+
+void bench_runner_free()
+{
+    mbedtls_free(samples);
+    samples = NULL;
+    samples_size = 0;
+}
+
+unsigned long bench_runner_repetitions()
+{
+    return repetitions;
+}
+
+void bench_runner_start(bench_runner_t *r, uint64_t duration_ns)
+{
+    memset(r, 0, sizeof(*r));
+    r->duration_ns = duration_ns;
+    r->batch = 1;
+    r->reps = repetitions;
+    if (r->reps > 1) {
+        reserve_samples(r->reps);
+    }
+
+    if (warmup_iterations > 0) {
+        r->phase = PHASE_WARMUP;
+    } else if (duration_ns > 0) {
+        r->phase = PHASE_GROW;
+    } else {
+        r->phase = PHASE_SAMPLE;
+    }
+}
+
+void bench_runner_start_samples(bench_runner_t *r, unsigned long n)
+{
+    memset(r, 0, sizeof(*r));
+    r->batch = 1;
+    r->reps = (n > 0) ? n : 1;
+    if (r->reps > 1) {
+        reserve_samples(r->reps);
+    }
+
+    r->phase = PHASE_SAMPLE;
+}
+
+unsigned long bench_runner_next(bench_runner_t *r)
+{
+    switch (r->phase) {
+        case PHASE_WARMUP:
+            return warmup_iterations;
+        case PHASE_DONE:
+            return 0;
+        default:
+            bench_timing_reset(&r->batch_m);
+            bench_timing_start(&r->batch_m);
+            return r->batch;
+    }
+}
+
+static void add_batch(bench_runner_t *r)
+{
+    r->m.ns += r->batch_m.ns;
+    r->m.cycles += r->batch_m.cycles;
+    r->m.iterations += r->batch_m.iterations;
+}
+
+void bench_runner_stop(bench_runner_t *r, unsigned long iterations)
+{
+    uint64_t ns;
+
+    r->calls += iterations;
+
+    if (r->phase == PHASE_WARMUP) {
+        r->phase = (r->duration_ns > 0) ? PHASE_GROW : PHASE_SAMPLE;
+        return;
+    }
+
+    ns = bench_timing_stop(&r->batch_m, iterations);
+
+    if (r->phase == PHASE_GROW && r->reps == 1) {
+        /* Every batch counts, they only grow to amortise the clock reads */
+        add_batch(r);
+        if (r->m.ns >= r->duration_ns) {
+            r->phase = PHASE_DONE;
+        } else if (ns < r->duration_ns / 16) {
+            r->batch *= 2;
+        }
+    } else if (r->phase == PHASE_GROW) {
+        /* Find the batch size of the samples; this also warms up */
+        if (ns >= r->duration_ns / r->reps) {
+            r->phase = PHASE_SAMPLE;
+        } else {
+            r->batch *= 2;
+        }
+    } else if (r->phase == PHASE_SAMPLE) {
+        add_batch(r);
+        if (samples != NULL && r->count < samples_size) {
+            samples[r->count] = bench_timing_ns_per_op(&r->batch_m);
+        }
+        if (++r->count >= r->reps) {
+            r->phase = PHASE_DONE;
+        }
+    }
+}
+
+static int compare_samples(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of the sorted samples */
+static double percentile(unsigned long n, unsigned long p)
+{
+    unsigned long rank = (p * n + 99) / 100;
+
+    return samples[rank > 0 ? rank - 1 : 0];
+}
+
+int bench_runner_stats(const bench_runner_t *r, bench_stats_t *stats)
+{
+    unsigned long i, n = r->count;
+    double sum = 0, sq = 0;
+
+    if (samples == NULL || n < 2 || n > samples_size) {
+        return -1;
+    }
+
+    qsort(samples, n, sizeof(samples[0]), compare_samples);
+
+    for (i = 0; i < n; i++) {
+        sum += samples[i];
+    }
+
+    stats->n = n;
+    stats->mean = sum / n;
+    for (i = 0; i < n; i++) {
+        sq += (samples[i] - stats->mean) * (samples[i] - stats->mean);
+    }
+
+    stats->min = samples[0];
+    stats->max = samples[n - 1];
+    if (n % 2 == 0) {
+        stats->median = (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    } else {
+        stats->median = samples[n / 2];
+    }
+    stats->p90 = percentile(n, 90);
+    stats->p99 = percentile(n, 99);
+    stats->stddev = sqrt(sq / (n - 1));
+
+    return 0;
+}
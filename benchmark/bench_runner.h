@@ -0,0 +1,156 @@
+/*
+ *  Repetitions and statistics for the benchmark
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _BENCH_RUNNER_H_
+#define _BENCH_RUNNER_H_
+
+#include <stdint.h>
+
+#include "bench_timing.h"
+
+/**
+ * Decides how many times the benchmarked code runs in each batch, and
+ * collects the timing of the batches.
+ *
+ * A run starts with the configured number of warm-up iterations, which are
+ * not timed. With a single repetition, the batches then grow until their
+ * total time reaches the duration of the run, and they are all added to the
+ * result. With several repetitions, the batches grow until one takes the
+ * duration divided by the number of repetitions, and the following batches
+ * of that size are the samples. A duration of 0 means one iteration per
+ * batch, for the operations that are timed one call at a time.
+ *
+ * The code is run as follows:
+ * \code
+ * bench_runner_start(&r, duration_ns);
+ * while ((batch = bench_runner_next(&r)) != 0) {
+ *     for (i = 0; i < batch; i++) {
+ *         ...
+ *     }
+ *     bench_runner_stop(&r, i);
+ * }
+ * \endcode
+ */
+typedef struct {
+    bench_measure_t m;          /**< Sum of the timed batches */
+    unsigned long calls;        /**< Iterations run, timed or not */
+    bench_measure_t batch_m;    /**< Private: the current batch */
+    uint64_t duration_ns;       /**< Private: duration of the run */
+    unsigned long batch;        /**< Private: iterations per batch */
+    unsigned long count;        /**< Private: number of samples taken */
+    unsigned long reps;         /**< Private: number of samples to take */
+    int phase;                  /**< Private: step of the run */
+} bench_runner_t;
+
+/**
+ * Statistics of the time of one iteration over the samples of a run
+ */
+typedef struct {
+    unsigned long n;            /**< Number of samples */
+    double min;                 /**< Fastest sample in nanoseconds */
+    double median;              /**< Median in nanoseconds */
+    double mean;                /**< Mean in nanoseconds */
+    double p90;                 /**< 90th percentile in nanoseconds */
+    double p99;                 /**< 99th percentile in nanoseconds */
+    double max;                 /**< Slowest sample in nanoseconds */
+    double stddev;              /**< Standard deviation in nanoseconds */
+} bench_stats_t;
+
+/**
+ * Configure the runs
+ *
+ * \param[in]   warmup
+ *              Number of iterations run before timing
+ * \param[in]   repetitions
+ *              Number of timed samples per run, at least 1
+ *
+ * \return  0 if successful, -1 if the samples could not be allocated. The
+ *          samples are allocated again by each thread when it needs them.
+ */
+int bench_runner_init(unsigned long warmup, unsigned long repetitions);
+
+/**
+ * Free the samples of the calling thread
+ */
+void bench_runner_free(void);
+
+/**
+ * Get the number of timed samples per run
+ *
+ * \return  The number of repetitions
+ */
+unsigned long bench_runner_repetitions(void);
+
+/**
+ * Start a run
+ *
+ * \param[out]  r
+ *              The runner
+ * \param[in]   duration_ns
+ *              Approximate time spent in timed batches, or 0 to time every
+ *              iteration separately
+ */
+void bench_runner_start(bench_runner_t *r, uint64_t duration_ns);
+
+/**
+ * Start a run of n samples of one iteration each, without warm-up, whatever
+ * the configured repetitions. This is meant for the operations whose time
+ * varies so much from one call to the next that its distribution matters.
+ *
+ * \param[out]  r
+ *              The runner
+ * \param[in]   n
+ *              Number of samples
+ */
+void bench_runner_start_samples(bench_runner_t *r, unsigned long n);
+
+/**
+ * Start the next batch
+ *
+ * \param[in,out]   r
+ *                  The runner
+ *
+ * \return  The number of iterations to run, or 0 at the end of the run
+ */
+unsigned long bench_runner_next(bench_runner_t *r);
+
+/**
+ * End the current batch
+ *
+ * \param[in,out]   r
+ *                  The runner
+ * \param[in]       iterations
+ *                  Number of iterations actually run
+ */
+void bench_runner_stop(bench_runner_t *r, unsigned long iterations);
+
+/**
+ * Compute the statistics of a run with several repetitions. This reorders
+ * the samples, so it may only be called once per run.
+ *
+ * \param[in]   r
+ *              The runner, at the end of the run
+ * \param[out]  stats
+ *              The statistics
+ *
+ * \return  0 if successful, -1 if there are fewer than 2 samples
+ */
+int bench_runner_stats(const bench_runner_t *r, bench_stats_t *stats);
+
+#endif /* _BENCH_RUNNER_H_ */
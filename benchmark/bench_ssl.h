@@ -0,0 +1,143 @@
+/*
+ *  TLS client and server connected in memory
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _BENCH_SSL_H_
+#define _BENCH_SSL_H_
+
+#include <stddef.h>
+
+#include "mbedtls/ssl.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/pk.h"
+
+#include "bench_timing.h"
+
+/**
+ * Bytes buffered in each direction of a connection. A side that sends more
+ * gets MBEDTLS_ERR_SSL_WANT_WRITE until the other side has read enough.
+ */
+#define BENCH_SSL_PIPE_LEN  4096
+
+/**
+ * One direction of a connection: the bytes sent by one side and not yet read
+ * by the other
+ */
+typedef struct {
+    unsigned char *buf;         /**< Ring buffer of BENCH_SSL_PIPE_LEN bytes */
+    size_t start;               /**< Offset of the first byte to read */
+    size_t len;                 /**< Number of bytes to read */
+} bench_ssl_pipe_t;
+
+/**
+ * A client and a server that only accept one ciphersuite, connected through
+ * memory instead of a network. The server has an RSA-2048 and an ECDSA P-256
+ * certificate, which the client verifies, and both sides share a PSK, so
+ * that the common key exchanges can be negotiated.
+ *
+ * The time spent by each side in the calls to Mbed TLS is measured
+ * separately. Both sides run on the calling thread and never wait for each
+ * other, so their times add up to the time of the whole exchange.
+ */
+typedef struct {
+    mbedtls_ssl_context client;         /**< Client side */
+    mbedtls_ssl_context server;         /**< Server side */
+    mbedtls_ssl_config client_conf;     /**< Private */
+    mbedtls_ssl_config server_conf;     /**< Private */
+    mbedtls_x509_crt ca;                /**< Private: CAs of the client */
+    mbedtls_x509_crt rsa_crt;           /**< Private */
+    mbedtls_x509_crt ec_crt;            /**< Private */
+    mbedtls_pk_context rsa_key;         /**< Private */
+    mbedtls_pk_context ec_key;          /**< Private */
+    bench_ssl_pipe_t to_server;         /**< Private: client to server */
+    bench_ssl_pipe_t to_client;         /**< Private: server to client */
+    int ciphersuites[2];                /**< Private: the suite, then 0 */
+    int connected;                      /**< Private: a handshake is done */
+    bench_measure_t client_m;           /**< Time spent by the client */
+    bench_measure_t server_m;           /**< Time spent by the server */
+} bench_ssl_pair_t;
+
+/**
+ * Initialize a pair so that it can be freed
+ *
+ * \param[out]  p
+ *              The pair
+ */
+void bench_ssl_init(bench_ssl_pair_t *p);
+
+/**
+ * Configure both sides of a pair for a ciphersuite
+ *
+ * \param[in,out]   p
+ *                  The pair, initialized with bench_ssl_init()
+ * \param[in]       ciphersuite
+ *                  Identifier of the ciphersuite
+ * \param[in]       mfl_code
+ *                  Maximum fragment length requested by the client, one of
+ *                  the MBEDTLS_SSL_MAX_FRAG_LEN_XXX values
+ * \param[in]       f_rng
+ *                  Random generator of both sides
+ * \param[in]       p_rng
+ *                  Context of the random generator
+ *
+ * \return  0 if successful, MBEDTLS_ERR_PLATFORM_FEATURE_UNSUPPORTED if the
+ *          key exchange of the ciphersuite needs credentials that the pair
+ *          does not have or if the maximum fragment length extension is
+ *          disabled, or an Mbed TLS error code
+ */
+int bench_ssl_setup(bench_ssl_pair_t *p, int ciphersuite,
+                    unsigned char mfl_code,
+                    int (*f_rng)(void *, unsigned char *, size_t),
+                    void *p_rng);
+
+/**
+ * Run a full handshake, after closing the previous connection if any. The
+ * time spent by each side is added to client_m and server_m.
+ *
+ * \param[in,out]   p
+ *                  The pair
+ *
+ * \return  0 if successful, or an Mbed TLS error code
+ */
+int bench_ssl_handshake(bench_ssl_pair_t *p);
+
+/**
+ * Send application data from the client to the server, after a handshake.
+ * The time spent by each side is added to client_m and server_m.
+ *
+ * \param[in,out]   p
+ *                  The pair
+ * \param[in,out]   buf
+ *                  The data to send, which is overwritten by the data
+ *                  received
+ * \param[in]       len
+ *                  Length of the data
+ *
+ * \return  0 if successful, or an Mbed TLS error code
+ */
+int bench_ssl_transfer(bench_ssl_pair_t *p, unsigned char *buf, size_t len);
+
+/**
+ * Free a pair
+ *
+ * \param[in,out]   p
+ *                  The pair
+ */
+void bench_ssl_free(bench_ssl_pair_t *p);
+
+#endif /* _BENCH_SSL_H_ */
@@ -0,0 +1,234 @@
+/*
+ *  Multi-threaded runs of the benchmark
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "mbed.h"
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif /* MBEDTLS_CONFIG_FILE */
+
+#include "mbedtls/platform.h"
+
+#include "bench_threads.h"
+
+#if defined(__MBED__)
+int bench_threads_run(unsigned long n, int (*fn)(void *), void *arg)
+{
+    if (n != 1) {
+        mbedtls_printf("Only one thread is supported on Mbed OS\n");
+        return -1;
+    }
+
+    return (fn(arg) == 0) ? 0 : -1;
+}
+
+unsigned long bench_threads_count()
+{
+    return 1;
+}
+
+unsigned long bench_threads_id()
+{
+    return 0;
+}
+
+void bench_threads_sync()
+{
+}
+
+double bench_threads_sum(double value)
+{
+    return value;
+}
+#else
+#include <pthread.h>
+
+typedef struct {
+    unsigned long id;
+    pthread_t thread;
+    int ret;
+} worker_t;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t released = PTHREAD_COND_INITIALIZER;
+
+static unsigned long count = 1;
+/*
+ * Threads still running, threads waiting in bench_threads_sync(), and the
+ * number of times the waiting threads were released
+ */
+static unsigned long active;
+static unsigned long waiting;
+static unsigned long generation;
+
+/*
+ * Totals of bench_threads_sum(), used in turn. The threads clear the next
+ * total before they meet, and the total before it may still be read by a slow
+ * thread, hence three of them.
+ */
+static double sums[3];
+
+static int (*run_fn)(void *);
+static void *run_arg;
+
+static __thread unsigned long thread_id;
+static __thread unsigned long thread_sums;
+
+/* Let the waiting threads go once all the active threads are waiting */
+static void release_if_complete()
+{
+    if (waiting > 0 && waiting == active) {
+        waiting = 0;
+        generation++;
+        pthread_cond_broadcast(&released);
+    }
+}
+
+static void *worker(void *p)
+{
+    worker_t *w = (worker_t *)p;
+
+    thread_id = w->id;
+    thread_sums = 0;
+    w->ret = run_fn(run_arg);
+
+    pthread_mutex_lock(&lock);
+    active--;
+    release_if_complete();
+    pthread_mutex_unlock(&lock);
+
+    return NULL;
+}
+
+int bench_threads_run(unsigned long n, int (*fn)(void *), void *arg)
+{
+    worker_t *workers;
+    unsigned long i, started;
+    int ret = 0;
+
+    if (n == 0) {
+        return -1;
+    }
+
+    workers = (worker_t *)mbedtls_calloc(n, sizeof(worker_t));
+    if (workers == NULL) {
+        mbedtls_printf("Failed to allocate %lu threads\n", n);
+        return -1;
+    }
+
+    run_fn = fn;
+    run_arg = arg;
+    count = n;
+    active = n;
+    waiting = 0;
+    sums[0] = sums[1] = sums[2] = 0;
+
+    /* The calling thread is thread 0 */
+    for (started = 1; started < n; started++) {
+        workers[started].id = started;
+        if (pthread_create(&workers[started].thread, NULL, worker,
+                           &workers[started]) != 0) {
+            mbedtls_printf("Failed to create thread %lu\n", started);
+            break;
+        }
+    }
+
+    if (started < n) {
+        /* The threads that were not created will never arrive */
+        pthread_mutex_lock(&lock);
+        active -= n - started;
+        pthread_mutex_unlock(&lock);
+        ret = -1;
+    }
+
+    workers[0].id = 0;
+    worker(&workers[0]);
+
+    for (i = 1; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    for (i = 0; i < started; i++) {
+        if (workers[i].ret != 0) {
+            ret = -1;
+        }
+    }
+
+    count = 1;
+    thread_sums = 0;
+    mbedtls_free(workers);
+
+    return ret;
+}
+
+unsigned long bench_threads_count()
+{
+    return count;
+}
+
+unsigned long bench_threads_id()
+{
+    return thread_id;
+}
+
+void bench_threads_sync()
+{
+    unsigned long my_generation;
+
+    if (count == 1) {
+        return;
+    }
+
+    pthread_mutex_lock(&lock);
+    my_generation = generation;
+    waiting++;
+    release_if_complete();
+    while (generation == my_generation) {
+        pthread_cond_wait(&released, &lock);
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+double bench_threads_sum(double value)
+{
+    double *sum;
+    double total;
+
+    if (count == 1) {
+        return value;
+    }
+
+    sum = &sums[thread_sums % 3];
+
+    pthread_mutex_lock(&lock);
+    *sum += value;
+    sums[(thread_sums + 1) % 3] = 0;
+    pthread_mutex_unlock(&lock);
+
+    bench_threads_sync();
+
+    pthread_mutex_lock(&lock);
+    total = *sum;
+    pthread_mutex_unlock(&lock);
+
+    thread_sums++;
+    return total;
+}
+#endif /* __MBED__ */
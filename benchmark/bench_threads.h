@@ -0,0 +1,84 @@
+/*
+ *  Multi-threaded runs of the benchmark
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _BENCH_THREADS_H_
+#define _BENCH_THREADS_H_
+
+/*
+ * State that each thread of a run needs its own copy of, such as the buffers
+ * processed by the primitives. The boards run a single thread.
+ */
+#if defined(__MBED__)
+#define BENCH_THREAD_LOCAL
+#else
+#define BENCH_THREAD_LOCAL  __thread
+#endif /* __MBED__ */
+
+/**
+ * Run a function on several threads at once and wait for them to finish. The
+ * calling thread is thread 0 and the others are created for the run.
+ *
+ * The threads take the same steps, so they meet at each call of
+ * bench_threads_sync() or bench_threads_sum(). A thread that returns early,
+ * for instance after an error, no longer takes part in the later steps.
+ *
+ * On Mbed OS only a single thread is supported.
+ *
+ * \param[in]   n
+ *              Number of threads, at least 1
+ * \param[in]   fn
+ *              The function run by every thread
+ * \param[in]   arg
+ *              Argument of the function
+ *
+ * \return  0 if the function returned 0 on every thread, -1 otherwise
+ */
+int bench_threads_run(unsigned long n, int (*fn)(void *), void *arg);
+
+/**
+ * Get the number of threads of the current run
+ *
+ * \return  The number of threads, 1 outside bench_threads_run()
+ */
+unsigned long bench_threads_count(void);
+
+/**
+ * Get the index of the calling thread in the current run
+ *
+ * \return  The index of the thread, 0 for the thread that started the run
+ */
+unsigned long bench_threads_id(void);
+
+/**
+ * Wait until every thread of the run reaches this step, so that they start
+ * timing together
+ */
+void bench_threads_sync(void);
+
+/**
+ * Add up a value over the threads of the run. Every thread gets the total.
+ *
+ * \param[in]   value
+ *              The contribution of the calling thread
+ *
+ * \return  The sum of the contributions of the threads
+ */
+double bench_threads_sum(double value);
+
+#endif /* _BENCH_THREADS_H_ */
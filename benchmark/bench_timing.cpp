@@ -0,0 +1,250 @@
+/*
+ *  High resolution timing for the benchmark
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "mbed.h"
+
+#include "bench_timing.h"
+
+#if defined(__MBED__)
+/* The DWT cycle counter is missing on Cortex-M0, M0+ and M23 */
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+#define BENCH_TIMING_DWT
+#endif
+#else
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_TIMING_RDTSC
+#endif
+#endif /* __MBED__ */
+
+/* Number of iterations and runs used to calibrate the empty loop */
+#define CALIBRATION_ITERATIONS  10000
+#define CALIBRATION_RUNS        8
+
+static int has_cycles;
+static double overhead_ns;
+static double overhead_cycles;
+
+#if defined(BENCH_TIMING_DWT)
+/* CYCCNT is 32 bits wide; these extend it to 64 bits */
+static uint32_t cyccnt_last;
+static uint64_t cyccnt_high;
+#endif /* BENCH_TIMING_DWT */
+
+#if defined(__MBED__)
+static Timer ticker_timer;
+#endif /* __MBED__ */
+
+static uint64_t read_cycles()
+{
+#if defined(BENCH_TIMING_DWT)
+    uint32_t now = DWT->CYCCNT;
+
+    /*
+     * The counter wraps every few tens of seconds, so this is correct as long
+     * as it is read at least once in each period. bench_timing_stop() adds
+     * the periods missed during a longer call.
+     */
+    if (now < cyccnt_last) {
+        cyccnt_high += (uint64_t)1 << 32;
+    }
+    cyccnt_last = now;
+
+    return cyccnt_high | now;
+#elif defined(BENCH_TIMING_RDTSC)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static uint64_t read_ns()
+{
+#if defined(__MBED__)
+    return ticker_timer.read_high_resolution_us() * 1000;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif /* __MBED__ */
+}
+
+MBED_NOINLINE static int empty_call()
+{
+    return 0;
+}
+
+/* Called through a volatile pointer so that the calls are not optimised out */
+static int (*volatile empty_fn)() = empty_call;
+
+/*
+ * Measure the same loop as BENCHMARK_FUNC_CALL around a call that does
+ * nothing. The fastest of several runs is the least disturbed by interrupts.
+ */
+static void calibrate()
+{
+    bench_measure_t m;
+    unsigned long i;
+    int run;
+    int ret = 0;
+    double ns, cycles;
+    double best_ns = 0, best_cycles = 0;
+
+    overhead_ns = 0;
+    overhead_cycles = 0;
+
+    for (run = 0; run < CALIBRATION_RUNS; run++) {
+        bench_timing_reset(&m);
+        bench_timing_start(&m);
+        for (i = 0; i < CALIBRATION_ITERATIONS; i++) {
+            ret = empty_fn();
+            if (ret != 0) {
+                break;
+            }
+        }
+        bench_timing_stop(&m, i);
+
+        ns = bench_timing_ns_per_op(&m);
+        cycles = bench_timing_cycles_per_op(&m);
+        if (run == 0 || ns < best_ns) {
+            best_ns = ns;
+        }
+        if (run == 0 || cycles < best_cycles) {
+            best_cycles = cycles;
+        }
+    }
+
+    overhead_ns = best_ns;
+    overhead_cycles = best_cycles;
+}
+
+void bench_timing_init()
+{
+#if defined(BENCH_TIMING_DWT)
+    uint32_t before;
+    volatile int i;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(__CORTEX_M) && (__CORTEX_M == 7U)
+    /* Unlock the DWT registers */
+    DWT->LAR = 0xC5ACCE55;
+#endif
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    /* Some devices do not let the software enable the counter */
+    before = DWT->CYCCNT;
+    for (i = 0; i < 100; i++);
+    has_cycles = (DWT->CYCCNT != before);
+    cyccnt_last = DWT->CYCCNT;
+    cyccnt_high = 0;
+#elif defined(BENCH_TIMING_RDTSC)
+    has_cycles = 1;
+#else
+    has_cycles = 0;
+#endif
+
+#if defined(__MBED__)
+    ticker_timer.start();
+#endif /* __MBED__ */
+
+    calibrate();
+}
+
+int bench_timing_has_cycles()
+{
+    return has_cycles;
+}
+
+void bench_timing_reset(bench_measure_t *m)
+{
+    memset(m, 0, sizeof(*m));
+}
+
+void bench_timing_start(bench_measure_t *m)
+{
+    m->start_ns = read_ns();
+    m->start_cycles = read_cycles();
+}
+
+uint64_t bench_timing_stop(bench_measure_t *m, unsigned long iterations)
+{
+    uint64_t cycles = read_cycles() - m->start_cycles;
+    uint64_t ns = read_ns() - m->start_ns;
+#if defined(BENCH_TIMING_DWT)
+    uint64_t ticker_cycles, wraps;
+
+    /*
+     * The cycle counter has a much better resolution than the ticker, but
+     * CYCCNT wraps every 2^32 cycles (about 43 s at 100 MHz) and read_cycles()
+     * only sees the wraps between two reads. A call longer than that, such as
+     * an RSA-4096 key generation, loses whole periods, so the number of
+     * periods is taken from the ticker, which is far more accurate than one
+     * period, and the cycle counter only gives the rest.
+     */
+    if (has_cycles) {
+        ticker_cycles = (uint64_t)((double)ns * SystemCoreClock / 1e9);
+        if (ticker_cycles > cycles) {
+            wraps = (ticker_cycles - cycles + ((uint64_t)1 << 31)) >> 32;
+            cycles += wraps << 32;
+        }
+        ns = (uint64_t)((double)cycles * 1e9 / SystemCoreClock);
+    }
+#endif /* BENCH_TIMING_DWT */
+
+    m->ns += ns;
+    m->cycles += cycles;
+    m->iterations += iterations;
+
+    return ns;
+}
+
+/*
+ * Remove the overhead of the loop from an average. A measurement below the
+ * overhead means that the calibration was disturbed, so it is left as is.
+ */
+static double remove_overhead(double per_op, double overhead)
+{
+    if (per_op > overhead) {
+        return per_op - overhead;
+    }
+
+    return per_op;
+}
+
+double bench_timing_ns_per_op(const bench_measure_t *m)
+{
+    if (m->iterations == 0) {
+        return 0;
+    }
+
+    return remove_overhead((double)m->ns / m->iterations, overhead_ns);
+}
+
+double bench_timing_cycles_per_op(const bench_measure_t *m)
+{
+    if (m->iterations == 0 || !has_cycles) {
+        return 0;
+    }
+
+    return remove_overhead((double)m->cycles / m->iterations,
+                           overhead_cycles);
+}
@@ -0,0 +1,104 @@
+/*
+ *  High resolution timing for the benchmark
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _BENCH_TIMING_H_
+#define _BENCH_TIMING_H_
+
+#include <stdint.h>
+
+/**
+ * Time and cycles spent running a piece of code a number of times.
+ *
+ * The elapsed time is read from CLOCK_MONOTONIC on a Linux host and from the
+ * DWT cycle counter (or the microsecond ticker if there is none) on Mbed OS.
+ * The cycles are read from DWT CYCCNT on Cortex-M and from the time stamp
+ * counter on x86 hosts.
+ */
+typedef struct {
+    uint64_t ns;                /**< Total elapsed time in nanoseconds */
+    uint64_t cycles;            /**< Total elapsed cycles */
+    unsigned long iterations;   /**< Number of times the code ran */
+    uint64_t start_ns;          /**< Private: time of the last start */
+    uint64_t start_cycles;      /**< Private: cycles at the last start */
+} bench_measure_t;
+
+/**
+ * Enable the cycle counter, if any, and calibrate the cost of an empty
+ * benchmark loop. This must be called before any other function below.
+ */
+void bench_timing_init(void);
+
+/**
+ * Check whether the cycles of the measurements are meaningful
+ *
+ * \return  1 if a cycle counter is available, 0 otherwise
+ */
+int bench_timing_has_cycles(void);
+
+/**
+ * Clear a measurement
+ *
+ * \param[out]  m
+ *              The measurement
+ */
+void bench_timing_reset(bench_measure_t *m);
+
+/**
+ * Start timing a batch of iterations
+ *
+ * \param[in,out]   m
+ *                  The measurement
+ */
+void bench_timing_start(bench_measure_t *m);
+
+/**
+ * Stop timing a batch of iterations and add it to the measurement
+ *
+ * \param[in,out]   m
+ *                  The measurement
+ * \param[in]       iterations
+ *                  Number of iterations run since bench_timing_start()
+ *
+ * \return  The time taken by the batch in nanoseconds
+ */
+uint64_t bench_timing_stop(bench_measure_t *m, unsigned long iterations);
+
+/**
+ * Get the average time of one iteration, without the calibrated overhead of
+ * the benchmark loop
+ *
+ * \param[in]   m
+ *              The measurement
+ *
+ * \return  The time in nanoseconds
+ */
+double bench_timing_ns_per_op(const bench_measure_t *m);
+
+/**
+ * Get the average cycles of one iteration, without the calibrated overhead
+ * of the benchmark loop
+ *
+ * \param[in]   m
+ *              The measurement
+ *
+ * \return  The number of cycles, or 0 if there is no cycle counter
+ */
+double bench_timing_cycles_per_op(const bench_measure_t *m);
+
+#endif /* _BENCH_TIMING_H_ */
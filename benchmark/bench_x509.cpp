@@ -0,0 +1,424 @@
+/*
+ *  Certificate chains of the X.509 benchmark
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "mbed.h"
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif /* MBEDTLS_CONFIG_FILE */
+
+#include "bench_x509.h"
+
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+
+#if defined(MBEDTLS_RSA_C)
+/* Self-signed root of the RSA-2048 chain */
+static const char rsa2048_root[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIDbTCCAlWgAwIBAgIUOelpBSFUyTCjnXQycF6HPYzyfWQwDQYJKoZIhvcNAQEL\n"
+    "BQAwRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMSAwHgYDVQQD\n"
+    "DBdCZW5jaG1hcmsgUlNBLTIwNDggUm9vdDAgFw0yNjEwMTcwMDEyNTJaGA8yMDU2\n"
+    "MTAwOTAwMTI1MlowRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVk\n"
+    "MSAwHgYDVQQDDBdCZW5jaG1hcmsgUlNBLTIwNDggUm9vdDCCASIwDQYJKoZIhvcN\n"
+    "AQEBBQADggEPADCCAQoCggEBAKmi97mqNOk8aPbZAVETyChuSxnxPa2OKB+bHk66\n"
+    "Tuc9mgSP7WMtJaknesMpL2o0v970UhI9FeEzD2npMYr/mP1LxWCNvTy/LCojd3ep\n"
+    "98hedgY32CyyxwusiGrt5WBUtz1q1zK4WgsWot98WEO8xiMKHezAX3IXzCoxq+ub\n"
+    "ju/IU0XBRibe0MNAXRYp0q8BisLPvC0qdlICK4Ga87w68AAwWKaGCR+WLMzlywUR\n"
+    "VeSHv1dcrDIIcqHnzKx2bOSRtUxxlcA08dTZDsUKsJ9TDKGgJsxhfPnSHtrM3ype\n"
+    "lqVHSHYk4+cO72Xm/sjSyZVRqzK2vtMCCoukjo9dl7b9bd0CAwEAAaNTMFEwHQYD\n"
+    "VR0OBBYEFPVSAzYvmZbfIprjGqZOdnlQkEHHMB8GA1UdIwQYMBaAFPVSAzYvmZbf\n"
+    "IprjGqZOdnlQkEHHMA8GA1UdEwEB/wQFMAMBAf8wDQYJKoZIhvcNAQELBQADggEB\n"
+    "ADMpBkaoj1Uk24iSOu5cNedFRZ192YRJfwp7FJOlAEfJRh6lm7KyIQoF4lj0CJFd\n"
+    "1s6zNROsVlQkQN9FXYV4oYyLFnf9mxM+A8KiDVm9JV389QpGAitBw2Z7JeiXzUsM\n"
+    "H8Q2k4op3AV2tfdAjzePS+eYIZ04V8LpwPt2/Rao4DLpk7lutBkSxDwl3CubWllO\n"
+    "u8wzvaacwAOuaOsOOyKBj4Qfl8qGSmW6zwL6MJ08/r0CuFEXtqqkAfwAckzqNJ8F\n"
+    "QxV69iWzue6HaJ1aVSKSfBbzcv1GffETHxnOxd+Z6YfFRZgJvR+yty8QFLtohRae\n"
+    "ekOiVE9KYl+6rJBbPCH+RYc=\n"
+    "-----END CERTIFICATE-----\n";
+
+/* RSA-2048 CA at depth 1 */
+static const char rsa2048_crt1[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIDbTCCAlWgAwIBAgIUW/IU45wlyuylH64SeW3xgIQr8hAwDQYJKoZIhvcNAQEL\n"
+    "BQAwRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMSAwHgYDVQQD\n"
+    "DBdCZW5jaG1hcmsgUlNBLTIwNDggUm9vdDAgFw0yNjEwMTcwMDEyNTJaGA8yMDU2\n"
+    "MTAwOTAwMTI1MlowRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVk\n"
+    "MSAwHgYDVQQDDBdCZW5jaG1hcmsgUlNBLTIwNDggQ0EgMTCCASIwDQYJKoZIhvcN\n"
+    "AQEBBQADggEPADCCAQoCggEBAJtzKtsgDPrn9D/ab0xdbM4ezwzHQzY887aV03P5\n"
+    "WwihQbzPLrHvDTjqjgjT5pJCN2Ptn+eeANVVcBd0bgLJkkZ3fB/apulYW5Ky3c1t\n"
+    "ss+zQCPnkmoLQPXuVh7utffg0yTMrd/09fh3/MxuIvb0gWgO7NQZ/pk9/MTQPe0h\n"
+    "Orh+TV7kWt8m3JMV13An7ihkcwzHTRWw5Z6CFhVFq2HfYdK68wqDdGSKqgcHoVyx\n"
+    "XhQCzqDu+Mg8oQrKbsj4wQgEcLLgFgkFB04n7iFKDoFnmf2SJGFHiKSQbLmCx2W3\n"
+    "1vVlc9ir97bo48ckOu70cJFNdqT2y4xowcf4PKwIen+kU5cCAwEAAaNTMFEwDwYD\n"
+    "VR0TAQH/BAUwAwEB/zAdBgNVHQ4EFgQUP7M51V1/TGDog1ty4ai1yNYxlXcwHwYD\n"
+    "VR0jBBgwFoAU9VIDNi+Zlt8imuMapk52eVCQQccwDQYJKoZIhvcNAQELBQADggEB\n"
+    "AIGTVcNTKVh4t0pPrdXVSISldoDiojIzp/6pR3g5pyh+nl8LOz1pzeGprRR3vglh\n"
+    "mjYKjr4smICX0ADWIBFmeJFWBnYezM7K3vKspbEfksyvvgiKOY6XSMzXWmZ0FWDw\n"
+    "HkK8y5sc7oDT/ABSOAKy01WkdBP4PCEqOiYF223pvPYKasPg5gzNCA/J5RqtlQGA\n"
+    "nR0riaUhN2MnYWKfOcjipnXUgo9nQDpGcyONS1ZYzuJzrO8RaYB0D3nsa+f3Ns/U\n"
+    "fNv35FBpk4L5GSdNwRjiNc3l2MG+5HESXy+ty7kgLXXwKrWCMSqRHF6EkxPMdjdj\n"
+    "MU824gbUWAECanArCcB0UrE=\n"
+    "-----END CERTIFICATE-----\n";
+
+/* RSA-2048 CA at depth 2 */
+static const char rsa2048_crt2[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIDbTCCAlWgAwIBAgIUC956NeQsIJVPaVaP81mVlhQLT2MwDQYJKoZIhvcNAQEL\n"
+    "BQAwRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMSAwHgYDVQQD\n"
+    "DBdCZW5jaG1hcmsgUlNBLTIwNDggQ0EgMTAgFw0yNjEwMTcwMDEyNTNaGA8yMDU2\n"
+    "MTAwOTAwMTI1M1owRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVk\n"
+    "MSAwHgYDVQQDDBdCZW5jaG1hcmsgUlNBLTIwNDggQ0EgMjCCASIwDQYJKoZIhvcN\n"
+    "AQEBBQADggEPADCCAQoCggEBAMaS8a0p+tSjW8npguj/wVR8FZsZPFvlrZr9Cika\n"
+    "7ytLoNgJmadopEytq+av2ReA1rNn7Op0VEp+OaX+B/pNfAlcWmiukmv6F2fOTu+6\n"
+    "9MoZh2fnvHB7yxn52sTuzv94iyn6cJlRFdcPzFPAhZEdWFT219w7GqZaUlthNK0N\n"
+    "EjawTYrc4WaoBbxmVTcor5NOeYMUP36B4e6OI7sCMY6JF96LMtX5JxnDGufXEhaY\n"
+    "CNEOfSOu/pc31b4XlrRZNfdRJ4HZYAtsKrCRkUsrpPSwbwu2QswMrOpm5FtMrdQd\n"
+    "G95N00j4+E4EwLLXjJHTgeHOPauKgqdqXwB08LS5/UYnrwECAwEAAaNTMFEwDwYD\n"
+    "VR0TAQH/BAUwAwEB/zAdBgNVHQ4EFgQUywxQp1HW7PTF6/3keZw+b7QUv+wwHwYD\n"
+    "VR0jBBgwFoAUP7M51V1/TGDog1ty4ai1yNYxlXcwDQYJKoZIhvcNAQELBQADggEB\n"
+    "AEE/8c6q04J+2uumsadkrbIvW0agvBWsx61cnpesYHF9xxaPqw1GUB5RBrfLs5ja\n"
+    "Isy/YVZ3lk0XHjcGHYNr4mcIWi9COBzcODssU+vajxtAnV7WcK0d78i89bAd88RF\n"
+    "uspYrNPleMRnsn9o6nmfZD6VgKRKgBqA/YBzTmIvrxabTWuLcjrJi66jFspMOQwB\n"
+    "3kZGEFCKKLxGEanrv8ZJZHdXlrTKMGetqRrq4FVa1nXaPAe4rveuHlNT0cOX7WCZ\n"
+    "ZRHQUEq4137s/67rqCfnmv9WBNW1g+GiR61ewGUjRHpHoG/A5z3S1wci2QJe4CKh\n"
+    "oF6evH5EtYQivmHavGCy7vA=\n"
+    "-----END CERTIFICATE-----\n";
+
+/* RSA-2048 CA at depth 3 */
+static const char rsa2048_crt3[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIDbTCCAlWgAwIBAgIUAM0bJ5hroiMlk/CBuIwi1UwVTOYwDQYJKoZIhvcNAQEL\n"
+    "BQAwRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMSAwHgYDVQQD\n"
+    "DBdCZW5jaG1hcmsgUlNBLTIwNDggQ0EgMjAgFw0yNjEwMTcwMDEyNTNaGA8yMDU2\n"
+    "MTAwOTAwMTI1M1owRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVk\n"
+    "MSAwHgYDVQQDDBdCZW5jaG1hcmsgUlNBLTIwNDggQ0EgMzCCASIwDQYJKoZIhvcN\n"
+    "AQEBBQADggEPADCCAQoCggEBANoine7jD/6+id+Z9RKNI06/dJ3HyUSuaOTdV2Vy\n"
+    "iTjI65UYVsvVCPxCWpdJE0F/RlpL5k9P1OxYg9wmH8aG7m4xXH+XEb3Ce1vwy+mG\n"
+    "RPpOmQr3TjDs2HVR7m3bNeLt+Ky9tw+BLxmes+9Az8DUdGeSBflO8Z0khegx/tR8\n"
+    "vjQj76KpecZyl/WznQjmSGYQyE2znqVB1+3Cm6OhVv6qzBDcyfEMwAmLFgUut0Q7\n"
+    "HHH+HiVNsJOK4YiHnM5HW8fdcnNAauxTTNPlb1KJ4cKc855fCseQ0MqNRxO89aMA\n"
+    "y/DgTs69LDnbYNx1YzivxQ892xBh04Nx9xULBkK4+4+Qm20CAwEAAaNTMFEwDwYD\n"
+    "VR0TAQH/BAUwAwEB/zAdBgNVHQ4EFgQUAXNMbm/96CqJVTUhL+BWRaNlK4IwHwYD\n"
+    "VR0jBBgwFoAUywxQp1HW7PTF6/3keZw+b7QUv+wwDQYJKoZIhvcNAQELBQADggEB\n"
+    "ADsrIGg0JfGTiG8gVye/9e6hUsT0+rIT7rQgHChUPfjk1ImLcaP18DJKqXMmvHPK\n"
+    "STOZoAFzE2X4dn1BUQcIuxs7NZ5aW1OaLV/k8SJe4WBGdD+MBrS2GRPngy2A2F4O\n"
+    "kZdaoL/6g5pOP0zBk+xsZv2upFebOug7TBGNuNkDdB1uAyFkUhqi+cDBm+5JvYmm\n"
+    "cfIo9vJa2Y9gTkipbj6VZPAHBcwe5NtLrPX2U+ImlbFfLKvnflUS6v+K55yREe/m\n"
+    "xS95nh4Kdc/UgGNJrA9UoJIJzNCi+UFaQ4z1vcErThefg6xEbhsZ/rfWa5Giff5+\n"
+    "SY8m4jQnxz0G8EfPVVfOG3s=\n"
+    "-----END CERTIFICATE-----\n";
+
+/* RSA-2048 certificate of the server, at depth 4 */
+static const char rsa2048_crt4[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIDWTCCAkGgAwIBAgIUFblrphZFLpP0az3qdjMZABYTcD8wDQYJKoZIhvcNAQEL\n"
+    "BQAwRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMSAwHgYDVQQD\n"
+    "DBdCZW5jaG1hcmsgUlNBLTIwNDggQ0EgMzAgFw0yNjEwMTcwMDEyNTNaGA8yMDU2\n"
+    "MTAwOTAwMTI1M1owNzELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVk\n"
+    "MRIwEAYDVQQDDAlsb2NhbGhvc3QwggEiMA0GCSqGSIb3DQEBAQUAA4IBDwAwggEK\n"
+    "AoIBAQCnSC5ukrlz7D5ZMx8F0Qpe6Bl8xz2Uap6bJRMet/z3Bmt8kFA970L+jpYA\n"
+    "RclhGrLYtVtI1lFh8xwXP9pmKF0I+P2biwV8vcprROZ6I+VGjfoUboylvBFra3dx\n"
+    "yASdeljxdgDY4afRPpC1aQa30YKT7cYl79fAKtGfXSNLMsbOgRDa1GrtmInhKPSx\n"
+    "B6pIJ7BdquRuJyxL6mXbBDSYAL7ErEDMVHxT5K0MdGIxue99SRYTJDs9weYaiisn\n"
+    "/99bY7fPwT6jUYx/A4/ABl3rrZqt4W4H/E+ba8rjP4+uK1Q9emKHD/5t+mYAX6YN\n"
+    "QIvsqdU9EZSjbB8Sky4YhedjOZWTAgMBAAGjTTBLMAkGA1UdEwQCMAAwHQYDVR0O\n"
+    "BBYEFLhmG36V2lT0H50bZo9qhuluy4MzMB8GA1UdIwQYMBaAFAFzTG5v/egqiVU1\n"
+    "IS/gVkWjZSuCMA0GCSqGSIb3DQEBCwUAA4IBAQCe3NdGk1sbkbfG1Ovu9qb+EkL/\n"
+    "H2h8R75LLED4rySY6O9CT7Es9EDqEdVarQwvBhQNyA746aPfYn50mct8M18MrqXO\n"
+    "1VmUBfZgloa21KRxxLxMsPJiSp/7iEogLNN0OtbeQpX46wYePXE7fDj2ODzsg/sF\n"
+    "dWPLQ3Hz/m1ub1WZlKWVoQjD5+SjlxuAO4FDEbSi8l9y6RCgdpnCNmrSSVdpTi8n\n"
+    "VTYEtRBl1Llc8H28hNMCdXis62sx9z6je3T6x8JQkfUx7QlHaoJdbltQcI/vbt1f\n"
+    "4TlDRRqI7NaYNlMJyLNyyj3UMli0nRvU9msSSHpswVCB5jyhMhPBTdld16k+\n"
+    "-----END CERTIFICATE-----\n";
+
+/* Self-signed root of the RSA-4096 chain */
+static const char rsa4096_root[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIFbTCCA1WgAwIBAgIUG5PjY4jKr3oKe23V+pRWUikMHZYwDQYJKoZIhvcNAQEL\n"
+    "BQAwRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMSAwHgYDVQQD\n"
+    "DBdCZW5jaG1hcmsgUlNBLTQwOTYgUm9vdDAgFw0yNjEwMTcwMDEyNTVaGA8yMDU2\n"
+    "MTAwOTAwMTI1NVowRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVk\n"
+    "MSAwHgYDVQQDDBdCZW5jaG1hcmsgUlNBLTQwOTYgUm9vdDCCAiIwDQYJKoZIhvcN\n"
+    "AQEBBQADggIPADCCAgoCggIBANcQR64RzylFNega5wG86g5ACeYVHLKBLe7zh9TC\n"
+    "ef0h0BI+BRBRx7LsTa2lssB4Dz7dIb31oF06qIRa5686HvvGVVJxoI/w0bK0uN+S\n"
+    "3B7H/BHAgLgKXAtlqi1a+QUZBXTo7JmedoaL2IUbDJLK/a92ui/Ow9tXtisWPZG1\n"
+    "GM0T2B73hLea3HaZIRI81pO49iv5k4QfSikVBHhSs1yasBM1YWoBOg5tTxWuSYu+\n"
+    "vBvqccUsrBY16Q9jZr6U6HhWsCsWJE+kid1NA4T/I5iDCLuCq2NFqeGEug58uY5E\n"
+    "6JOvEpHhS8FFgd6THYT1DOSoTVxu8rXZchglaifw4YZWWbLE1pt/5dZRlwRNxCov\n"
+    "TxJaRTS6y6K8kBN/DJz0GEWPBDNKDdyQcFWee86pk7mBT8EhWUQGHDUSErfpjJln\n"
+    "7crUyDc6wNc7ZKAT0nb7rfYAbJRLRnNGwwBI7vLLzNJw1jrfg8ekC1YBDjtFJ2C4\n"
+    "B4hwebPHwOep0blsT0Y2s4sE4rDAgQRM+e3yzK/wmtsiNwFDFHBcmzZf+k1GP5TC\n"
+    "jXJ4V677I5PN8qTwOx5huHsO65a11H9GCc4O5P7ASNVFsxz7JPYO8SXJRJHWapMA\n"
+    "h63eeSIHZeYf4vc592DxsqxTaHbW9v9jLqxsSkIKaO9vsaKPkIHVhPbs8TSEDrpn\n"
+    "5kzpAgMBAAGjUzBRMB0GA1UdDgQWBBTeEHM3aDZymFgebWe8i6JGugMaYjAfBgNV\n"
+    "HSMEGDAWgBTeEHM3aDZymFgebWe8i6JGugMaYjAPBgNVHRMBAf8EBTADAQH/MA0G\n"
+    "CSqGSIb3DQEBCwUAA4ICAQDPO9eOfLuSoDbmgdhjPXKJjLzJZZQr5IPOnRDaeQ/n\n"
+    "c6O5mi7TzXY5NlRuXCgrbtFQqjRtUsU6S2qQksAzsFereqpD3YgtOF2diIuZLIDx\n"
+    "Yjn/BtvMBB8q8foOHYanPql18XJ+DMEGIFMcOeuxaLIrXlKKEMi4nF6RFuyFd/as\n"
+    "Ev4N1t7PXxCXImaDD/n8qEWvfDP9EbhUYupKC+IcJELAJB6/YSF/ou+JAH5YTwuE\n"
+    "/7ZuymewFTukfZBAxjYAn5oG0umEMXlelMNNLsddLamGCPe35TREACYvJZ9xEe5J\n"
+    "KYXXYvaMidMbcZqHN/ZY0PlNIhb7msCLXgjI3/EXjd+Ucd2vr/VoyKc6Hb4zk7QV\n"
+    "85+OgCRewR1w8a4ed3t3cbOV9yQRCV3z6j0rjTCRS84jbVQWGLGyCGEU0YfqWNud\n"
+    "Sl7fjcY59woWQdlVIq90fSrPtwmg0nIZIFAM2+ezViPbyCIdGxpapMpzOzLSbhvo\n"
+    "GHhohBEAnijvROsyCFJElS/n8AsUFtpL5C+PbANYJupQNRaYazzcuBJZeaLhKyDM\n"
+    "qoppaddrdKqpMmhUk4Jjeq+l7E/WYeW1oDYgMiIiTjBcqPrZ2VYHsFKFMWFrRPba\n"
+    "UzZXCUhVPdAH8DwcoufgchyR5xdR2CLb/g1jZv5iT0Smt3lHRCox6q2oUluBBby2\n"
+    "bg==\n"
+    "-----END CERTIFICATE-----\n";
+
+/* RSA-4096 CA at depth 1 */
+static const char rsa4096_crt1[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIFbTCCA1WgAwIBAgIUTTee8RD4QW/sz5q5boH7HtnzW8cwDQYJKoZIhvcNAQEL\n"
+    "BQAwRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMSAwHgYDVQQD\n"
+    "DBdCZW5jaG1hcmsgUlNBLTQwOTYgUm9vdDAgFw0yNjEwMTcwMDEyNTZaGA8yMDU2\n"
+    "MTAwOTAwMTI1NlowRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVk\n"
+    "MSAwHgYDVQQDDBdCZW5jaG1hcmsgUlNBLTQwOTYgQ0EgMTCCAiIwDQYJKoZIhvcN\n"
+    "AQEBBQADggIPADCCAgoCggIBALEd+bk6MetX0XZomJPlF4QZ+5Ver7AdoGLEG1Vv\n"
+    "gLRpeu9FNPYREmkW0f/Me3y2fESLgWCP2elJdsBa9LF4FvjptQR78cRaKVKyiVcR\n"
+    "qc3kofV1PfT3qwV5Zpop0HS5CEQChilrht97StVXYLdljTZqwvgZMzJfiQR8St9Z\n"
+    "rLCFJzJ6g8KgNtHNkL2lFGgAxFKfZVnrpulABNa7xB+KQCafFGn1bRIcfr3xfMD7\n"
+    "ghcA8StHaNK68JU/OyJ1A3HR7Y9PE/DLsty4f4LlmngHQ4wjTRi9VlBi1jBM6K93\n"
+    "6VT4/EZHbLz8yb6BNWrQQX+yjldyt3DUmc+iPt91GjJr1bM44hhiCbhiDEh6hrsh\n"
+    "cZCWPooelNu1KRBqsEAo4fBF2Jxuc0/rQESp0p482QQfF1QQaKN/WHPiQiWgCgu0\n"
+    "c3c9sQuCQVR2kiDlWAj4r8vPj7EU65h5ublT3M7ATlYijUl5guMQT6hEePE7IfO+\n"
+    "QGkoNj6g/a556L3REUksnVTA+/sLQg7BYN7Zq31zQ8hKfogU+FGLEQBfgINnMHPu\n"
+    "OCwW8SS+jmNdrPE7gN0uP9UorekYfUq300Y7HL8y9dq2aMnV9p5oz8nF9mkzF8HU\n"
+    "vt7B5q9RrN6rGbWE3a6fI0jd1OVoEEalBEgenoXSMqBQuA/mlPYmQd+n+UlXnSeT\n"
+    "n79TAgMBAAGjUzBRMA8GA1UdEwEB/wQFMAMBAf8wHQYDVR0OBBYEFASQVs9xW4K6\n"
+    "XtdQTVV88nXjBocmMB8GA1UdIwQYMBaAFN4QczdoNnKYWB5tZ7yLoka6AxpiMA0G\n"
+    "CSqGSIb3DQEBCwUAA4ICAQAk/KlKgqFeNBi18XrX+BxSzzORbUmT5+O+sRzg+tI9\n"
+    "ogR+7pEUF+ZqAB5lhPZbTlOJSaatMLLUHh9HFWXZxP+wS2TsHhb1YciOwwmSL89q\n"
+    "DwgDViTjmP+yrZPhDeXfPhSCINncoHadCCkvfaVwMNKtG73uyFZvJ6bXP0+nC7Id\n"
+    "LLAw+9FHxAmrB6sd1aWzs8FqCSUPXtVId5b1dTcUVcZ3O2Vy5b+6NFTyG1lyONoD\n"
+    "QA85oV+oRPrGxLsAJEwnLjS8RXHiVqr9METk5OpwjhMB2AiT5X6ekkTIzKB25LZx\n"
+    "2RN3bH6GEyzZqcj23maMy5yFEyPZQKaHKAcVgCuNb4/g9zHEFAJgicB7wlXsxA8N\n"
+    "hKCgms+AipuRhZIW4tP6khcMoRFK5U/azczv8fJsly3M1q/pk1QdVXXcJF4R74HD\n"
+    "exQIQlMfbAGl9skrOUn/d1jjpcvFxms+PxVgwjM+y5ky3jnlCqytkFFN0XFmkyUL\n"
+    "ngQj9NDwNBf1ePxo4bkz28kZ1OUdH8QhlMhiUKT+kOtc7bv9zrqMStsBeY4RCs54\n"
+    "a/geJ6UhDwJ0op7AJnI01CuB4eM8z9ZjoHp5PtTHaRmutO+UdzIiK8byQAcDj83/\n"
+    "j0EUYsdJDHMWRNBotoOVZLzyNrbSsuR5K1krHb91JjHyKL361pc6j34XaBiJt9b4\n"
+    "DQ==\n"
+    "-----END CERTIFICATE-----\n";
+
+/* RSA-4096 CA at depth 2 */
+static const char rsa4096_crt2[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIFbTCCA1WgAwIBAgIURdgyVav7tq29+63Su3h1Qtp33r8wDQYJKoZIhvcNAQEL\n"
+    "BQAwRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMSAwHgYDVQQD\n"
+    "DBdCZW5jaG1hcmsgUlNBLTQwOTYgQ0EgMTAgFw0yNjEwMTcwMDEyNThaGA8yMDU2\n"
+    "MTAwOTAwMTI1OFowRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVk\n"
+    "MSAwHgYDVQQDDBdCZW5jaG1hcmsgUlNBLTQwOTYgQ0EgMjCCAiIwDQYJKoZIhvcN\n"
+    "AQEBBQADggIPADCCAgoCggIBAK2uiFUl1m/XrmU6Tloz5iMsOKIDDKdz3fKOVojQ\n"
+    "KUqTiLM17qevNCBANT/SNpSx1xsHU/GXp1SQ0MSWmZur4K9tolBch9Tl66kmAlKk\n"
+    "OxVA+TWcIdzuDkCcNCOKqKc9OI2VlQgUmiot0EdHMLJaRpokVbk80V4IR6Px2JqK\n"
+    "HotJyJH0B3VW36qM8voVSfko069cMQNwCmT9B264uNv0cxlkZ5t9eW6RlWUk32mk\n"
+    "sMkMKhCAxRWNIXo/Ktb8sdP638Kz67ubNfbbz1r6DjYZAgRmeE9LF1pucFCYpe/7\n"
+    "uU862IBRxpGBJGai4YyZGP+HRKNhob1SNo8rs//9fLzpX6kMSVFGLjAP9dEOPx3f\n"
+    "Bn4ptVMM0SuswKGmG47BjqhEAiLtBJYMFC4pN1F22eHXcjUJXaZP+BmPPN9qldLB\n"
+    "wtKQ3SpVzQ1yNRAjjdADTMSYtxrpByOwJ+l2NgxVW3IfjYuDJqq9MDtGR3zh6qbU\n"
+    "hOoRO9YEgLNFLpRsfpOO1K2pE7w6ruehDJYWWQulhqUIZ4EbGIM28/fu7dJgNp3g\n"
+    "7H37QS+xIACR23yiHsm4TgIeBVfhKB2z5ssVP3AKLy2qxTxvT/Qb7Dynz00LWiMq\n"
+    "apYbkDmcCHsPVyrmQxfcFWErO4Lwq6Xou3BBpmJjG211yGPHBhgFVE/iQXU9MJPu\n"
+    "PE/RAgMBAAGjUzBRMA8GA1UdEwEB/wQFMAMBAf8wHQYDVR0OBBYEFD4H4lIJ1W/P\n"
+    "aXsDq/wqbfQqb688MB8GA1UdIwQYMBaAFASQVs9xW4K6XtdQTVV88nXjBocmMA0G\n"
+    "CSqGSIb3DQEBCwUAA4ICAQCIOyrx3/FuSFltaW6LpCPgPuVKLlm6zD38ElJii/HL\n"
+    "eke7daEmea63SqCslr0EQJV4A2iF5RcD5u9INJACfzWNhnhvre0DqvSZhk9S7aVk\n"
+    "/OjDBEw+A5sDm6im9/oOpZ8iX892JWt7AJPJAmKjhnXcZlNAxbu6ZCjZSRWrvY+c\n"
+    "BbWIQw5OA/JqlfEj+pcLl0E7dwuXYT5qhZPZbmK/YlyExuE1xbsJ85CBHlm7zl4B\n"
+    "tXFHbdrFvAmdxyllgQzrAbre9zkJ7QBmfr/UowOiEaicf3w+BoP5E4uYly9RHB5W\n"
+    "brkFKTSa1NbBuQygdZN1pyJ+gFgIMKWn1/lGthSXYSy3G4BUZlWbiJYmYSW4sn+O\n"
+    "c0aMgfQWtD4YozLFcV02NYP2O3ZEQ5HD7Z1xsQpHvhWF4mcfphorpLAbkY2v3MkM\n"
+    "voTuV1AYnG9Bi6IqPXoCm9o8/P6Hju5A9CLdz336cItmnaVtUqoWbLri1GBPwX/X\n"
+    "byJIHQsJwIIpPAZ4TVlE40XSNxOk3iILUqFSJ8wS4JThehsUEZzD01xJzcR+ykOX\n"
+    "qPRXnv/G+IO26UZCYWYfxtPLFTMNySKBK8+R5PMfA5GbGzxdJkf8eSGhCENYjGa/\n"
+    "mEFnxxxxE/jLI/LVjIcsocGLy22M7sU2HdrKi73mch/Mv3CXQnpG8yi0Y76GqE3j\n"
+    "hA==\n"
+    "-----END CERTIFICATE-----\n";
+
+/* RSA-4096 CA at depth 3 */
+static const char rsa4096_crt3[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIFbTCCA1WgAwIBAgIUB7tieRJS5hiUcWxkgHKZNDbb9kcwDQYJKoZIhvcNAQEL\n"
+    "BQAwRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMSAwHgYDVQQD\n"
+    "DBdCZW5jaG1hcmsgUlNBLTQwOTYgQ0EgMjAgFw0yNjEwMTcwMDEyNTlaGA8yMDU2\n"
+    "MTAwOTAwMTI1OVowRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVk\n"
+    "MSAwHgYDVQQDDBdCZW5jaG1hcmsgUlNBLTQwOTYgQ0EgMzCCAiIwDQYJKoZIhvcN\n"
+    "AQEBBQADggIPADCCAgoCggIBAKnVrQOS70FPUjYFyTQVhSbiNuRuGjL2ch3BlvPq\n"
+    "kwuLb/6OfBCy1ZNc3yjh6+4XqhorrVrTMwvrjUP7URPsNhX1U+OvWtVQFhA7nniC\n"
+    "7GlTccVYU5QsDAYFxtcbK+cf9JZZMMna4eMui2rqgZeo0MinkZWpogD2C/MMYtcp\n"
+    "m4ythdw8tTHouBl/4dKvgAx992FT7bBoLd/xXxfj2Emf1X495R7PP6NWbidamlg5\n"
+    "8xmZoqdotcBUDwckNaj/8nBol0uHrYAQnCBDBpXSC66HB7KQeI4Cqfwv6E46Hi4T\n"
+    "0BpODhO9peXuR/UhheZQVAaSKTyrwcJMzaBTgROVp/Nkb3y3Y7RNPzySGc6ffoJg\n"
+    "0CZu3XX4fRYftN85nTkR+Bt/bi5ujYYSpcbeuCErrRYb73Mh5vhjeuKrRQjLhAAO\n"
+    "kiayr/z3hk0dc7EpY+Q2CRgAPEMu9lUeHGzo99P77q+ia2EVLUjAWLqY++aaqpFD\n"
+    "yvBij2YK+PG39akVL5SWHNqVXAzbzcDbwdaNxK6GExW48dThjH+RgNIeOVDMkj3M\n"
+    "fLkj2jzw3tAvxYIw3770SihfSF4CXBnhtoRov7LhwOi5BIgyJ1BAFW1/fcWCnt9u\n"
+    "XRoZX0stv9ybQdNJmClQI2MmGOMd6f9LsvjTTve9Z6diHJDdXuSlTFxTBubNE/GT\n"
+    "CSaTAgMBAAGjUzBRMA8GA1UdEwEB/wQFMAMBAf8wHQYDVR0OBBYEFBRL3Bd8+w12\n"
+    "h5M7Z6ACrFtGYRLtMB8GA1UdIwQYMBaAFD4H4lIJ1W/PaXsDq/wqbfQqb688MA0G\n"
+    "CSqGSIb3DQEBCwUAA4ICAQCZe8SR23kx+XC3OPiml/KWdFj8SXc5jCwM5EELRwbN\n"
+    "XcdxM6PXAfOTkNqnmdHXnbwUwhJGcROFiC14aZD/iD8MuypueTLmhcXtLxvukpc4\n"
+    "OMTfMxq/JNyYAdnVQqmtNTu4SVys8cEJu7ZDR59rDhE6jEGXHSSveVuNeExWKKJw\n"
+    "YYhBhraOA/m9C5Pca0GgW8BnBIS3IDkY2mRxqDvwvoL9TnS5qwGfM/qzIBDPb2Tr\n"
+    "rWR/TqS6l1s/sU4EuPz2EXvzP5LukzrdO9HfNVyoQZBmzr/rrxMbVFFQ0OTUlwN0\n"
+    "7V3IEglC+EpOjSz8YKg1MqY9BgkrvfZsV55tmEcE0FoAUV7vhfTaBJRT3o9JJMrZ\n"
+    "O+SO22ZHGdNvXA7TqUm7YpNB+5nA6dkxq4pTKXtxPsB/noJMr3MCr87qe6KRotpY\n"
+    "0nehnaBMFb6HSaCoKkUIs70aTap2Lael3VBEjlRoNhbYdwrA34Gws/UtxK2FzOk8\n"
+    "3dLLRUPLGzNbvypKqWwOme8uj3etLKE/quBxWzCUxjgUjRmA6guIN7BQE7HtQ9QW\n"
+    "EPKzke9VODfuEqop5eha0iLmd9+7e6fB+IqcGP8YFqmoHPMao5VbeXSYKhh3u9DP\n"
+    "YBxtImLrXnWyKfKuq3o0T3t/JIVp6a+wWo2FmW+TcmuN5bNbcgsIX33S0IDFX7PK\n"
+    "/Q==\n"
+    "-----END CERTIFICATE-----\n";
+
+/* RSA-4096 certificate of the server, at depth 4 */
+static const char rsa4096_crt4[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIFWTCCA0GgAwIBAgIUd9TgzxHM5WO/7oNF83SVe4VjcE0wDQYJKoZIhvcNAQEL\n"
+    "BQAwRTELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMSAwHgYDVQQD\n"
+    "DBdCZW5jaG1hcmsgUlNBLTQwOTYgQ0EgMzAgFw0yNjEwMTcwMDEzMDBaGA8yMDU2\n"
+    "MTAwOTAwMTMwMFowNzELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVk\n"
+    "MRIwEAYDVQQDDAlsb2NhbGhvc3QwggIiMA0GCSqGSIb3DQEBAQUAA4ICDwAwggIK\n"
+    "AoICAQCnVMR8sN3I6zJ2owRquU43nrNomrU4xx/7nXp0hjVM0tKRM8Qf5L9F5ckI\n"
+    "8gfNgaZFEBODuvB9vTV56zSNkToCHuFE68e2IcH0XZrhUYEN8rOlX51N9HK30jFp\n"
+    "c3n9PUpOczXHx3sNqdavyYoBc2YjnHcrfYGtIHfG5sMZTvKYasVQT6taAmaIkEv8\n"
+    "//LfVpM889Z0iVx4bUSeWa6pHwrLnoHUjY/b9v08bL/ZEsnSpsSJ4s4f7JB9nQdZ\n"
+    "+gKk1rmM6dwE1Lcn1YGq/nbLJwdmi8kM/MuIgiPV2PekPj7zT8HA0+9CCVvUsBB7\n"
+    "36dl/QcupLXMOWmmLY/S7NSdv/q2ASPgXZuzPRvZRFyHsy3lR8qzzEu5lE6/ux0T\n"
+    "4eAsCz0+S8exxVA+J6PlLobrVmu6BzpEKnJ0gAhaWuV7ZTiWCVStqLY1/r/Wtyp+\n"
+    "YmNrMjoy//y2EZdWv6n18aiQddxcqzY2ocpalJY33dxSS1kyVlqVCzNELdXZnl96\n"
+    "w7QKwWGXzXpLKqfXiHHy4Ku21MBc0Ck6CB+AzIGMcWWhtupwb3FDEXY64flH0+j/\n"
+    "r8NRqoz9+De9FplskBTFS7oCbr4huGtOBFrDL6tDMuS3IMtRXcmMDtA4Y828eL65\n"
+    "l60uwvj83sZMuBlGw0NeSvO+oVcVNkml5MiP5H7HvYR1Y2FJOQIDAQABo00wSzAJ\n"
+    "BgNVHRMEAjAAMB0GA1UdDgQWBBSLOQmwd2Pskqs5efWkIXatWoOp5DAfBgNVHSME\n"
+    "GDAWgBQUS9wXfPsNdoeTO2egAqxbRmES7TANBgkqhkiG9w0BAQsFAAOCAgEAZR3q\n"
+    "+KHf5XUMLYaIci6HfW4Zmwe4juGaGJ0JtyXpUyxh5xvodsdJS4HBU/1DGmmY3rxZ\n"
+    "b8/GSvMqi0TC3khX4x5yS6SNRPCW1y3Nc/wFLggro+Nnk9al/SgD62UVDWfGgKfT\n"
+    "F11fz6moJDFo/0M+I8hafxLi5RUyhq97MgJXZrKPDwXwXchF4ossm7D4tVyEIwnj\n"
+    "AgQkOHHynjDRqGNsaQ116nk36SvamjVbwWSiP/QuMY63WqQGTUZhSb+IkBnJ9HEb\n"
+    "FrDB7PVher0/wJfY2f0zn0Xq/Mlpot0zu0wggwvMUzM/GL7CUgTLSIzk+g3S9Dat\n"
+    "Vf7Lw4JN9ezuENLlQ8pn93TqgeFa5ltm1Cm+qXC3qLrHF4JIaBWZG1G1hNKz0rJu\n"
+    "OsqPFr0CpgpLfG0qCMEX3FjJ/Dd10ZSpmEx/r7dkV6Hk/sVve0SHFXc5/AkakcPH\n"
+    "nWV3bnMAZsewBXWazLOVPwcOVcl24DAy4v3v3Urn5z17HPtI+cJP/XixhabUvjNG\n"
+    "hfLworGHPUpCxmQ1RvCBxpvEUWZzsHr4//2llF9QHJkhfbu2bbf/u2KB/BL6H8A6\n"
+    "dJWXpTVMIPa5I6so7nkAErx3Tqp0qPLrUDwXycK5PXLw61PVkIDXOgiStOHerryl\n"
+    "ejZq5dZZXf0MGwExhdGB+dgVqYsvTao0QjPSi0E=\n"
+    "-----END CERTIFICATE-----\n";
+#endif /* MBEDTLS_RSA_C */
+
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+/* Self-signed root of the P-256 chain */
+static const char p256_root[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIB3DCCAYGgAwIBAgIUdmTnb3x8uFHkjz7zXXuXzaoaZwEwCgYIKoZIzj0EAwIw\n"
+    "QjELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMR0wGwYDVQQDDBRC\n"
+    "ZW5jaG1hcmsgUC0yNTYgUm9vdDAgFw0yNjEwMTcwMDEzMDBaGA8yMDU2MTAwOTAw\n"
+    "MTMwMFowQjELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMR0wGwYD\n"
+    "VQQDDBRCZW5jaG1hcmsgUC0yNTYgUm9vdDBZMBMGByqGSM49AgEGCCqGSM49AwEH\n"
+    "A0IABNjXWymvCe9tAMf+HaNy4aqh9+dXMLirmGoNle7DdQ/gsm0RAvFSG3dxUInC\n"
+    "zMw2btiRXbRTXYLKsz9Lhl8OVAKjUzBRMB0GA1UdDgQWBBQLRSls+CcqVh6UnBRY\n"
+    "2AhuIhiWfDAfBgNVHSMEGDAWgBQLRSls+CcqVh6UnBRY2AhuIhiWfDAPBgNVHRMB\n"
+    "Af8EBTADAQH/MAoGCCqGSM49BAMCA0kAMEYCIQCeN0Kg7rg7DuAuEijkigLih4VY\n"
+    "GUYLL1mC6E7PlksDYAIhAKJHMOAC3Hjwk7bIE6znUIogLYX56D2x7VdhapVHXWV0\n"
+    "-----END CERTIFICATE-----\n";
+
+/* P-256 CA at depth 1 */
+static const char p256_crt1[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIB2jCCAYGgAwIBAgIUaL09kv6Q2Lxac/bxzi8nMzwFXh4wCgYIKoZIzj0EAwIw\n"
+    "QjELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMR0wGwYDVQQDDBRC\n"
+    "ZW5jaG1hcmsgUC0yNTYgUm9vdDAgFw0yNjEwMTcwMDEzMDBaGA8yMDU2MTAwOTAw\n"
+    "MTMwMFowQjELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMR0wGwYD\n"
+    "VQQDDBRCZW5jaG1hcmsgUC0yNTYgQ0EgMTBZMBMGByqGSM49AgEGCCqGSM49AwEH\n"
+    "A0IABOPYLyluUoTIcyc9k6QWALDa9p5y79MhQj7QZjiUz3V8z/QblcBSamZoXNEi\n"
+    "ieDw7FVasVFjO2ggmMAwLowpx/mjUzBRMA8GA1UdEwEB/wQFMAMBAf8wHQYDVR0O\n"
+    "BBYEFAtGosPewXBwxKdS3yqf1j4oOE2iMB8GA1UdIwQYMBaAFAtFKWz4JypWHpSc\n"
+    "FFjYCG4iGJZ8MAoGCCqGSM49BAMCA0cAMEQCIAxeCBqxYIDqSt97NZbw11MYICMY\n"
+    "FOK05gJZKSdgPOvbAiBzZj3PqNVDRFvOI3YPVwUzmwGuLwJOI4Z/ZFe5b0u8JA==\n"
+    "-----END CERTIFICATE-----\n";
+
+/* P-256 CA at depth 2 */
+static const char p256_crt2[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIB2zCCAYGgAwIBAgIUYRu81bObXQDVLCfKbdFZrJmTohEwCgYIKoZIzj0EAwIw\n"
+    "QjELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMR0wGwYDVQQDDBRC\n"
+    "ZW5jaG1hcmsgUC0yNTYgQ0EgMTAgFw0yNjEwMTcwMDEzMDBaGA8yMDU2MTAwOTAw\n"
+    "MTMwMFowQjELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMR0wGwYD\n"
+    "VQQDDBRCZW5jaG1hcmsgUC0yNTYgQ0EgMjBZMBMGByqGSM49AgEGCCqGSM49AwEH\n"
+    "A0IABJALUlYD7NMni4jdPM86Y3F+2KEAusbsyV6p1Qnqts4jpITbx5J/ucS2CHa9\n"
+    "RkYQaB+JmpH1LyYI81Bt1V6b32SjUzBRMA8GA1UdEwEB/wQFMAMBAf8wHQYDVR0O\n"
+    "BBYEFG6JQoARES+U44b6mTXFy4sZjjz/MB8GA1UdIwQYMBaAFAtGosPewXBwxKdS\n"
+    "3yqf1j4oOE2iMAoGCCqGSM49BAMCA0gAMEUCIQCGQg96QR7Q2pNyp0VFmXJVizMy\n"
+    "2w29s7AfKjXKLhB5mAIgZME/l+BoFpIav5hueqfQe9kk3u4tvP47qqV+TPULDl0=\n"
+    "-----END CERTIFICATE-----\n";
+
+/* P-256 CA at depth 3 */
+static const char p256_crt3[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIB3DCCAYGgAwIBAgIUSukrGXpaDEcmA3VhxA1/8Bk4C9owCgYIKoZIzj0EAwIw\n"
+    "QjELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMR0wGwYDVQQDDBRC\n"
+    "ZW5jaG1hcmsgUC0yNTYgQ0EgMjAgFw0yNjEwMTcwMDEzMDBaGA8yMDU2MTAwOTAw\n"
+    "MTMwMFowQjELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMR0wGwYD\n"
+    "VQQDDBRCZW5jaG1hcmsgUC0yNTYgQ0EgMzBZMBMGByqGSM49AgEGCCqGSM49AwEH\n"
+    "A0IABJ8xbRIbVwf7Ojo5HwnYCuvV6nWrG08MK6NI7Kwoyvwaz9pqlH3YeOA3U3nl\n"
+    "7rGJfhSlqjRAGRG9/ICpJM2YKW2jUzBRMA8GA1UdEwEB/wQFMAMBAf8wHQYDVR0O\n"
+    "BBYEFCUJvBfZfeJQ52y5QyODPbg+HcRJMB8GA1UdIwQYMBaAFG6JQoARES+U44b6\n"
+    "mTXFy4sZjjz/MAoGCCqGSM49BAMCA0kAMEYCIQDo1mSykb6/HkdI7EXS4b0HCVkO\n"
+    "nmb5IpqXFe4q57fa5AIhAJcJLi0LZ6xpzXBYju8SXDSNWWeiNNbpYzHiPIuJh3DW\n"
+    "-----END CERTIFICATE-----\n";
+
+/* P-256 certificate of the server, at depth 4 */
+static const char p256_crt4[] =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIByjCCAXCgAwIBAgIUZtnOd7D4UUCD19YwbqpjR9xvyhowCgYIKoZIzj0EAwIw\n"
+    "QjELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMR0wGwYDVQQDDBRC\n"
+    "ZW5jaG1hcmsgUC0yNTYgQ0EgMzAgFw0yNjEwMTcwMDEzMDBaGA8yMDU2MTAwOTAw\n"
+    "MTMwMFowNzELMAkGA1UEBhMCVUsxFDASBgNVBAoMC0FybSBMaW1pdGVkMRIwEAYD\n"
+    "VQQDDAlsb2NhbGhvc3QwWTATBgcqhkjOPQIBBggqhkjOPQMBBwNCAASZYP2bfPle\n"
+    "DU5Vws0kPwze8irM/kfgRFjUAukCs9qRlkaDZmG4VjuK08OaQNv1ZCI95G1w0iiD\n"
+    "bE9bqGaWRWUKo00wSzAJBgNVHRMEAjAAMB0GA1UdDgQWBBTdiCxyGVyJJzTRNlyW\n"
+    "vv3wlwZ61zAfBgNVHSMEGDAWgBQlCbwX2X3iUOdsuUMjgz24Ph3ESTAKBggqhkjO\n"
+    "PQQDAgNIADBFAiA+hTWcEMuY7gyywiHX49mMxkj/5cNgS7XlkwrgFwpiYQIhAN3J\n"
+    "u6nKFiayI3PQ+xQS+DzETL/tuqm2cULo6Q4+9tVk\n"
+    "-----END CERTIFICATE-----\n";
+#endif /* MBEDTLS_ECDSA_C && MBEDTLS_ECP_DP_SECP256R1_ENABLED */
+
+const bench_x509_chain_t bench_x509_chains[] = {
+#if defined(MBEDTLS_RSA_C)
+    {
+        "RSA-2048", 2048, rsa2048_root,
+        { rsa2048_crt1, rsa2048_crt2, rsa2048_crt3, rsa2048_crt4 }
+    },
+    {
+        "RSA-4096", 4096, rsa4096_root,
+        { rsa4096_crt1, rsa4096_crt2, rsa4096_crt3, rsa4096_crt4 }
+    },
+#endif /* MBEDTLS_RSA_C */
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+    {
+        "P-256", 256, p256_root,
+        { p256_crt1, p256_crt2, p256_crt3, p256_crt4 }
+    },
+#endif /* MBEDTLS_ECDSA_C && MBEDTLS_ECP_DP_SECP256R1_ENABLED */
+    { NULL, 0, NULL, { NULL, NULL, NULL, NULL } }
+};
+
+#endif /* MBEDTLS_X509_CRT_PARSE_C */
@@ -0,0 +1,53 @@
+/*
+ *  Certificate chains of the X.509 benchmark
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _BENCH_X509_H_
+#define _BENCH_X509_H_
+
+#include <stddef.h>
+
+/** Number of certificates under the root of each chain */
+#define BENCH_X509_DEPTH    4
+
+/**
+ * A chain of certificates of one public key algorithm, signed with SHA-256:
+ * a self-signed root, then one certificate at each depth from 1 to
+ * BENCH_X509_DEPTH, each signed by the one above it. The certificates above
+ * the last one are CAs, and the last one is the certificate of a server
+ * named "localhost". All of them are valid from 2026 to 2056.
+ *
+ * To verify a chain of depth N, the certificates from depth N up to depth 1
+ * are sent, as a TLS server does, and the root is trusted, so that N
+ * signatures are verified.
+ */
+typedef struct {
+    const char *name;                   /**< Algorithm, such as "RSA-2048" */
+    unsigned long key_bits;             /**< Size of the keys */
+    const char *root;                   /**< Root, in PEM */
+    const char *crts[BENCH_X509_DEPTH]; /**< Certificate at each depth from 1,
+                                             in PEM */
+} bench_x509_chain_t;
+
+/**
+ * The chains of the public key algorithms of the build: RSA-2048, RSA-4096
+ * and ECDSA P-256, followed by a chain whose name is NULL
+ */
+extern const bench_x509_chain_t bench_x509_chains[];
+
+#endif /* _BENCH_X509_H_ */
@@ -96,3 +96,34 @@
 #if !defined(MBEDTLS_ECDH_C)
 #define MBEDTLS_ECDH_C
 #endif
+
+#if !defined(MBEDTLS_PLATFORM_MEMORY)
+#define MBEDTLS_PLATFORM_MEMORY
+#endif
+
+/*
+ * ECP settings compared by the ECP tuning mode, from mbed_app.json or from
+ * the options of the host build
+ */
+#if defined(MBED_CONF_APP_ECP_WINDOW_SIZE) && !defined(MBEDTLS_ECP_WINDOW_SIZE)
+#define MBEDTLS_ECP_WINDOW_SIZE         MBED_CONF_APP_ECP_WINDOW_SIZE
+#endif
+
+#if defined(MBED_CONF_APP_ECP_FIXED_POINT_OPTIM) && \
+    !defined(MBEDTLS_ECP_FIXED_POINT_OPTIM)
+#define MBEDTLS_ECP_FIXED_POINT_OPTIM   MBED_CONF_APP_ECP_FIXED_POINT_OPTIM
+#endif
+
+/* MPI window size compared by the bignum mode, set in the same way */
+#if defined(MBED_CONF_APP_MPI_WINDOW_SIZE) && !defined(MBEDTLS_MPI_WINDOW_SIZE)
+#define MBEDTLS_MPI_WINDOW_SIZE         MBED_CONF_APP_MPI_WINDOW_SIZE
+#endif
+
+/*
+ * Restartable ECC for the restartable ECC benchmark, set in the same way.
+ * Mbed TLS does not support it with the legacy ECDH context.
+ */
+#if defined(MBED_CONF_APP_ECP_RESTARTABLE) && MBED_CONF_APP_ECP_RESTARTABLE
+#define MBEDTLS_ECP_RESTARTABLE
+#undef MBEDTLS_ECDH_LEGACY_CONTEXT
+#endif
@@ -0,0 +1,41 @@
+/*
+ *  Host (POSIX) shim for the Mbed OS Kernel namespace
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _KERNEL_H_
+#define _KERNEL_H_
+
+#include <stdint.h>
+
+namespace rtos {
+
+/**
+ * Functions acting on the kernel
+ */
+namespace Kernel {
+
+/**
+ * Read the tick count of the kernel, in milliseconds from CLOCK_MONOTONIC
+ */
+uint64_t get_ms_count();
+
+} // namespace Kernel
+
+} // namespace rtos
+
+#endif /* _KERNEL_H_ */
@@ -0,0 +1,37 @@
+/*
+ *  Host (POSIX) shim for the Mbed OS NetworkInterface class
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "NetworkInterface.h"
+
+NetworkInterface *NetworkInterface::get_default_instance()
+{
+    static NetworkInterface host_interface;
+
+    return &host_interface;
+}
+
+nsapi_error_t NetworkInterface::connect()
+{
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t NetworkInterface::disconnect()
+{
+    return NSAPI_ERROR_OK;
+}
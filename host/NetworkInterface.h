@@ -0,0 +1,55 @@
+/*
+ *  Host (POSIX) shim for the Mbed OS NetworkInterface class
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _NETWORKINTERFACE_H_
+#define _NETWORKINTERFACE_H_
+
+#include "nsapi_types.h"
+
+/**
+ * The network of the host is brought up by the operating system, so this
+ * class only exists to give the examples the same entry points they use on
+ * Mbed OS.
+ */
+class NetworkInterface
+{
+public:
+    virtual ~NetworkInterface() {}
+
+    /**
+     * Return the network interface of the host
+     */
+    static NetworkInterface *get_default_instance();
+
+    /**
+     * Bring up the interface. This is a no-op on the host.
+     *
+     * \return  NSAPI_ERROR_OK
+     */
+    virtual nsapi_error_t connect();
+
+    /**
+     * Bring down the interface. This is a no-op on the host.
+     *
+     * \return  NSAPI_ERROR_OK
+     */
+    virtual nsapi_error_t disconnect();
+};
+
+#endif /* _NETWORKINTERFACE_H_ */
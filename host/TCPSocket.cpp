@@ -0,0 +1,248 @@
+/*
+ *  Host (POSIX) shim for the Mbed OS TCPSocket class
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "TCPSocket.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+TCPSocket::TCPSocket() :
+    fd(-1),
+    addresses(NULL),
+    next_address(NULL),
+    connecting(false),
+    opened(false),
+    timeout(-1)
+{
+}
+
+TCPSocket::~TCPSocket()
+{
+    close();
+}
+
+nsapi_error_t TCPSocket::open(NetworkInterface *stack)
+{
+    if (stack == NULL)
+        return NSAPI_ERROR_PARAMETER;
+
+    opened = true;
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t TCPSocket::connect(const char *host, uint16_t port)
+{
+    struct addrinfo hints;
+    char port_str[6];
+
+    if (!opened)
+        return NSAPI_ERROR_NO_SOCKET;
+    if (connecting) {
+        if (wait(POLLOUT, 0) != NSAPI_ERROR_OK)
+            return NSAPI_ERROR_ALREADY;
+        return connect_result();
+    }
+    if (fd >= 0)
+        return NSAPI_ERROR_IS_CONNECTED;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+    snprintf(port_str, sizeof(port_str), "%u", port);
+
+    if (getaddrinfo(host, port_str, &hints, &addresses) != 0) {
+        addresses = NULL;
+        return NSAPI_ERROR_DNS_FAILURE;
+    }
+    next_address = addresses;
+
+    return connect_next();
+}
+
+nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
+{
+    ssize_t ret;
+    nsapi_error_t err;
+
+    if (fd < 0 || connecting)
+        return NSAPI_ERROR_NO_CONNECTION;
+
+    if (timeout != 0 && (err = wait(POLLOUT, timeout)) != NSAPI_ERROR_OK)
+        return err;
+
+    ret = ::send(fd, data, size, MSG_NOSIGNAL);
+    if (ret >= 0)
+        return static_cast<nsapi_size_or_error_t>(ret);
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        return NSAPI_ERROR_WOULD_BLOCK;
+    if (errno == EPIPE || errno == ECONNRESET)
+        return NSAPI_ERROR_CONNECTION_LOST;
+
+    return NSAPI_ERROR_DEVICE_ERROR;
+}
+
+nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
+{
+    ssize_t ret;
+    nsapi_error_t err;
+
+    if (fd < 0 || connecting)
+        return NSAPI_ERROR_NO_CONNECTION;
+
+    if (timeout != 0 && (err = wait(POLLIN, timeout)) != NSAPI_ERROR_OK)
+        return err;
+
+    ret = ::recv(fd, data, size, 0);
+    if (ret >= 0)
+        return static_cast<nsapi_size_or_error_t>(ret);
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        return NSAPI_ERROR_WOULD_BLOCK;
+    if (errno == ECONNRESET)
+        return NSAPI_ERROR_CONNECTION_LOST;
+
+    return NSAPI_ERROR_DEVICE_ERROR;
+}
+
+void TCPSocket::set_blocking(bool blocking)
+{
+    set_timeout(blocking ? -1 : 0);
+}
+
+void TCPSocket::set_timeout(int in_timeout)
+{
+    timeout = in_timeout;
+}
+
+nsapi_error_t TCPSocket::wait_ready(bool write, int in_timeout)
+{
+    if (fd < 0)
+        return NSAPI_ERROR_NO_CONNECTION;
+
+    return wait(write ? POLLOUT : POLLIN, in_timeout);
+}
+
+nsapi_error_t TCPSocket::close()
+{
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    if (addresses != NULL) {
+        freeaddrinfo(addresses);
+        addresses = NULL;
+        next_address = NULL;
+    }
+    connecting = false;
+    opened = false;
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t TCPSocket::wait(short events, int in_timeout)
+{
+    struct pollfd pfd;
+    int ret;
+
+    pfd.fd = fd;
+    pfd.events = events;
+    pfd.revents = 0;
+
+    do {
+        ret = poll(&pfd, 1, in_timeout);
+    } while (ret < 0 && errno == EINTR);
+
+    if (ret < 0)
+        return NSAPI_ERROR_DEVICE_ERROR;
+    if (ret == 0)
+        return NSAPI_ERROR_WOULD_BLOCK;
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t TCPSocket::connect_next()
+{
+    struct addrinfo *cur;
+
+    while ((cur = next_address) != NULL) {
+        next_address = cur->ai_next;
+
+        fd = socket(cur->ai_family, cur->ai_socktype, cur->ai_protocol);
+        if (fd < 0)
+            continue;
+
+        /* The socket API waits in wait() so the descriptor never blocks */
+        if (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK) != 0) {
+            close();
+            return NSAPI_ERROR_DEVICE_ERROR;
+        }
+
+        if (::connect(fd, cur->ai_addr, cur->ai_addrlen) == 0) {
+            connecting = true;
+            return connect_result();
+        }
+
+        if (errno == EINPROGRESS) {
+            connecting = true;
+            if (timeout == 0)
+                return NSAPI_ERROR_IN_PROGRESS;
+            if (wait(POLLOUT, timeout) != NSAPI_ERROR_OK)
+                return NSAPI_ERROR_IN_PROGRESS;
+            return connect_result();
+        }
+
+        ::close(fd);
+        fd = -1;
+    }
+
+    freeaddrinfo(addresses);
+    addresses = NULL;
+
+    return NSAPI_ERROR_NO_CONNECTION;
+}
+
+nsapi_error_t TCPSocket::connect_result()
+{
+    int err = 0;
+    socklen_t len = sizeof(err);
+
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) != 0)
+        err = errno;
+
+    connecting = false;
+    if (err == 0) {
+        freeaddrinfo(addresses);
+        addresses = NULL;
+        next_address = NULL;
+        return NSAPI_ERROR_OK;
+    }
+
+    ::close(fd);
+    fd = -1;
+
+    return connect_next();
+}
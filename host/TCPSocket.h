@@ -0,0 +1,178 @@
+/*
+ *  Host (POSIX) shim for the Mbed OS TCPSocket class
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _TCPSOCKET_H_
+#define _TCPSOCKET_H_
+
+#include "nsapi_types.h"
+#include "NetworkInterface.h"
+
+#include <stdint.h>
+
+struct addrinfo;
+
+/**
+ * A TCP socket backed by a POSIX file descriptor. Only the subset of the
+ * Mbed OS API used by the examples is provided.
+ */
+class TCPSocket
+{
+public:
+    /**
+     * Construct a closed socket
+     */
+    TCPSocket();
+
+    /**
+     * Close the socket if it is still open
+     */
+    ~TCPSocket();
+
+    /**
+     * Open the socket on the given network interface
+     *
+     * \param[in]   stack
+     *              The network interface (unused on the host)
+     *
+     * \return  NSAPI_ERROR_OK if successful
+     */
+    nsapi_error_t open(NetworkInterface *stack);
+
+    /**
+     * Resolve the host name and connect to the server. As on Mbed OS, a
+     * non-blocking socket returns NSAPI_ERROR_IN_PROGRESS while the
+     * connection is being established; wait_ready() for writing then call
+     * connect() again until it returns NSAPI_ERROR_IS_CONNECTED. A blocking
+     * socket waits for at most the timeout set with set_timeout().
+     *
+     * \param[in]   host
+     *              The host name or IP address of the server
+     * \param[in]   port
+     *              The port number of the server
+     *
+     * \return  NSAPI_ERROR_OK or NSAPI_ERROR_IS_CONNECTED if connected,
+     *          NSAPI_ERROR_IN_PROGRESS or NSAPI_ERROR_ALREADY if the
+     *          connection is still being established or another negative
+     *          error code
+     */
+    nsapi_error_t connect(const char *host, uint16_t port);
+
+    /**
+     * Send data to the server
+     *
+     * \return  The number of bytes sent, NSAPI_ERROR_WOULD_BLOCK if the
+     *          operation would block or another negative error code
+     */
+    nsapi_size_or_error_t send(const void *data, nsapi_size_t size);
+
+    /**
+     * Receive data from the server
+     *
+     * \return  The number of bytes received, 0 if the connection was closed,
+     *          NSAPI_ERROR_WOULD_BLOCK if the operation would block or another
+     *          negative error code
+     */
+    nsapi_size_or_error_t recv(void *data, nsapi_size_t size);
+
+    /**
+     * Equivalent to set_timeout(-1) when blocking and set_timeout(0)
+     * otherwise
+     */
+    void set_blocking(bool blocking);
+
+    /**
+     * Set the timeout in milliseconds of send() and recv(). A negative value
+     * blocks indefinitely.
+     */
+    void set_timeout(int timeout);
+
+    /**
+     * Wait until send() or recv() can proceed without blocking, whatever
+     * the timeout of the socket. This is not part of the Mbed OS API, where
+     * the examples wait for the callback of sigio() instead.
+     *
+     * \param[in]   write
+     *              true to wait for send(), false to wait for recv()
+     * \param[in]   timeout
+     *              The timeout in milliseconds, or a negative value to wait
+     *              indefinitely
+     *
+     * \return  NSAPI_ERROR_OK if the socket is ready, NSAPI_ERROR_WOULD_BLOCK
+     *          if the timeout expired or another negative error code
+     */
+    nsapi_error_t wait_ready(bool write, int timeout);
+
+    /**
+     * Close the socket
+     *
+     * \return  NSAPI_ERROR_OK if successful
+     */
+    nsapi_error_t close();
+
+private:
+    /**
+     * Wait until the socket is ready for the requested events, for at most
+     * timeout milliseconds
+     */
+    nsapi_error_t wait(short events, int timeout);
+
+    /**
+     * Start connecting to the next address of the host, moving on to the
+     * following ones while the connection fails at once
+     */
+    nsapi_error_t connect_next();
+
+    /**
+     * Check the outcome of the connection in progress and move on to the
+     * next address if it failed
+     */
+    nsapi_error_t connect_result();
+
+    /**
+     * The underlying file descriptor, or -1 if not connected
+     */
+    int fd;
+
+    /**
+     * The resolved addresses of the host while connecting, or NULL
+     */
+    struct addrinfo *addresses;
+
+    /**
+     * The address to try if the connection in progress fails
+     */
+    struct addrinfo *next_address;
+
+    /**
+     * Whether the connection on fd is still being established
+     */
+    bool connecting;
+
+    /**
+     * Whether open() has been called
+     */
+    bool opened;
+
+    /**
+     * Timeout of send() and recv() in milliseconds
+     */
+    int timeout;
+};
+
+#endif /* _TCPSOCKET_H_ */
@@ -0,0 +1,49 @@
+/*
+ *  Host (POSIX) shim for the Mbed OS ThisThread namespace
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "ThisThread.h"
+
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+
+namespace rtos {
+
+namespace ThisThread {
+
+void yield()
+{
+    sched_yield();
+}
+
+void sleep_for(uint32_t millisec)
+{
+    struct timespec ts;
+
+    ts.tv_sec = millisec / 1000;
+    ts.tv_nsec = static_cast<long>(millisec % 1000) * 1000000;
+
+    /* Sleep again for the time left if a signal interrupts the sleep */
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+        ;
+}
+
+} // namespace ThisThread
+
+} // namespace rtos
@@ -0,0 +1,46 @@
+/*
+ *  Host (POSIX) shim for the Mbed OS ThisThread namespace
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _THISTHREAD_H_
+#define _THISTHREAD_H_
+
+#include <stdint.h>
+
+namespace rtos {
+
+/**
+ * Functions acting on the calling thread
+ */
+namespace ThisThread {
+
+/**
+ * Let the other threads that are ready to run use the CPU
+ */
+void yield();
+
+/**
+ * Sleep for the given time in milliseconds
+ */
+void sleep_for(uint32_t millisec);
+
+} // namespace ThisThread
+
+} // namespace rtos
+
+#endif /* _THISTHREAD_H_ */
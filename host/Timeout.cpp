@@ -0,0 +1,81 @@
+/*
+ *  Host (POSIX) shim for the Mbed OS Timeout class
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "Timeout.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace mbed {
+
+struct Timeout::State {
+    std::mutex lock;
+    std::condition_variable cancelled;
+    std::thread worker;
+    bool pending;
+};
+
+Timeout::Timeout() :
+    state(new State())
+{
+    state->pending = false;
+}
+
+Timeout::~Timeout()
+{
+    detach();
+    delete state;
+}
+
+void Timeout::attach(void (*func)(void), float t)
+{
+    attach_us(func, static_cast<us_timestamp_t>(t * 1000000.0f));
+}
+
+void Timeout::attach_us(void (*func)(void), us_timestamp_t t)
+{
+    detach();
+
+    state->pending = true;
+    state->worker = std::thread([this, func, t]() {
+        std::unique_lock<std::mutex> guard(state->lock);
+
+        if (!state->cancelled.wait_for(guard, std::chrono::microseconds(t),
+                                       [this]() { return !state->pending; })) {
+            state->pending = false;
+            func();
+        }
+    });
+}
+
+void Timeout::detach()
+{
+    {
+        std::lock_guard<std::mutex> guard(state->lock);
+        state->pending = false;
+    }
+    state->cancelled.notify_all();
+
+    if (state->worker.joinable())
+        state->worker.join();
+}
+
+} // namespace mbed
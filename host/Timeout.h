@@ -0,0 +1,72 @@
+/*
+ *  Host (POSIX) shim for the Mbed OS Timeout class
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _TIMEOUT_H_
+#define _TIMEOUT_H_
+
+#include "Timer.h"
+
+namespace mbed {
+
+/**
+ * Call a function once after a delay. On Mbed OS the function runs in
+ * interrupt context; on the host it runs in a helper thread, so it must only
+ * do what would also be safe in an interrupt handler.
+ */
+class Timeout
+{
+public:
+    Timeout();
+
+    /**
+     * Cancel the pending call, if any
+     */
+    ~Timeout();
+
+    /**
+     * Call func after t seconds, replacing any pending call
+     */
+    void attach(void (*func)(void), float t);
+
+    /**
+     * Call func after t microseconds, replacing any pending call
+     */
+    void attach_us(void (*func)(void), us_timestamp_t t);
+
+    /**
+     * Cancel the pending call, if any
+     */
+    void detach();
+
+private:
+    /* Not copyable: the helper thread refers to this object */
+    Timeout(const Timeout &);
+    Timeout &operator=(const Timeout &);
+
+    /**
+     * Helper thread and synchronisation state, kept out of the header so
+     * that mbed.h does not pull <thread> and friends into the examples
+     */
+    struct State;
+    State *state;
+};
+
+} // namespace mbed
+
+#endif /* _TIMEOUT_H_ */
@@ -0,0 +1,88 @@
+/*
+ *  Host (POSIX) shim for the Mbed OS Timer class
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "Timer.h"
+
+#include <time.h>
+
+namespace mbed {
+
+Timer::Timer() :
+    start_us(0),
+    elapsed_us(0),
+    running(false)
+{
+}
+
+void Timer::start()
+{
+    if (!running) {
+        start_us = now_us();
+        running = true;
+    }
+}
+
+void Timer::stop()
+{
+    if (running) {
+        elapsed_us += now_us() - start_us;
+        running = false;
+    }
+}
+
+void Timer::reset()
+{
+    elapsed_us = 0;
+    start_us = now_us();
+}
+
+float Timer::read()
+{
+    return static_cast<float>(read_high_resolution_us()) / 1000000.0f;
+}
+
+int Timer::read_ms()
+{
+    return static_cast<int>(read_high_resolution_us() / 1000);
+}
+
+int Timer::read_us()
+{
+    return static_cast<int>(read_high_resolution_us());
+}
+
+us_timestamp_t Timer::read_high_resolution_us()
+{
+    if (running)
+        return elapsed_us + (now_us() - start_us);
+
+    return elapsed_us;
+}
+
+us_timestamp_t Timer::now_us()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return static_cast<us_timestamp_t>(ts.tv_sec) * 1000000 +
+           static_cast<us_timestamp_t>(ts.tv_nsec) / 1000;
+}
+
+} // namespace mbed
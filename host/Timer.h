@@ -0,0 +1,96 @@
+/*
+ *  Host (POSIX) shim for the Mbed OS Timer class
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _TIMER_H_
+#define _TIMER_H_
+
+#include <stdint.h>
+
+namespace mbed {
+
+typedef uint64_t us_timestamp_t;
+
+/**
+ * A stopwatch measuring elapsed time with CLOCK_MONOTONIC
+ */
+class Timer
+{
+public:
+    Timer();
+
+    /**
+     * Start the timer
+     */
+    void start();
+
+    /**
+     * Stop the timer, keeping the time elapsed so far
+     */
+    void stop();
+
+    /**
+     * Reset the elapsed time to 0
+     */
+    void reset();
+
+    /**
+     * Get the elapsed time in seconds
+     */
+    float read();
+
+    /**
+     * Get the elapsed time in milliseconds
+     */
+    int read_ms();
+
+    /**
+     * Get the elapsed time in microseconds
+     */
+    int read_us();
+
+    /**
+     * Get the elapsed time in microseconds without truncation to int
+     */
+    us_timestamp_t read_high_resolution_us();
+
+private:
+    /**
+     * Read the monotonic clock in microseconds
+     */
+    static us_timestamp_t now_us();
+
+    /**
+     * Time at which the timer was last started
+     */
+    us_timestamp_t start_us;
+
+    /**
+     * Time accumulated while the timer was running before the last start()
+     */
+    us_timestamp_t elapsed_us;
+
+    /**
+     * Whether the timer is running
+     */
+    bool running;
+};
+
+} // namespace mbed
+
+#endif /* _TIMER_H_ */
@@ -0,0 +1,170 @@
+/*
+ *  Check that a DER array in a source file matches its PEM certificate
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/**
+ * \file check_der.cpp
+ *
+ * \brief Check a certificate embedded as a C array against its PEM file
+ *
+ * Usage: check_der <PEM file> <source file> <array name>
+ *
+ * The boards have no custom build step, so the trusted CAs are committed as
+ * C arrays converted from their PEM files. This decodes the PEM file and
+ * compares it with the bytes of the array, so that an edit of either one is
+ * not silently left out of the other.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * Decode the base64 body of the first certificate of a PEM file
+ */
+static int decode_pem(std::ifstream &pem, std::vector<unsigned char> &der)
+{
+    static const char alphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string line;
+    const char *digit;
+    unsigned long bits = 0;
+    int nbits = 0;
+    bool body = false;
+    size_t i;
+
+    while (std::getline(pem, line)) {
+        if (!line.empty() && line[line.size() - 1] == '\r')
+            line.erase(line.size() - 1);
+        if (line == "-----BEGIN CERTIFICATE-----") {
+            body = true;
+            continue;
+        }
+        if (line == "-----END CERTIFICATE-----")
+            return body ? 0 : -1;
+        if (!body)
+            continue;
+
+        for (i = 0; i < line.size() && line[i] != '='; i++) {
+            digit = strchr(alphabet, line[i]);
+            if (digit == NULL || line[i] == '\0')
+                return -1;
+            bits = ((bits << 6) | (digit - alphabet)) & 0xFFFFFF;
+            nbits += 6;
+            if (nbits >= 8) {
+                nbits -= 8;
+                der.push_back((bits >> nbits) & 0xFF);
+            }
+        }
+    }
+
+    return -1;
+}
+
+/*
+ * Read the bytes between the braces of "name[] = {" in a source file
+ */
+static int read_array(std::ifstream &source, const std::string &name,
+                      std::vector<unsigned char> &der)
+{
+    std::stringstream text;
+    std::string content;
+    size_t start, end;
+    const char *p;
+    char *next;
+    unsigned long byte;
+
+    text << source.rdbuf();
+    content = text.str();
+
+    start = content.find(name + "[] = {");
+    if (start == std::string::npos)
+        return -1;
+    start = content.find('{', start) + 1;
+    end = content.find('}', start);
+    if (end == std::string::npos)
+        return -1;
+    content = content.substr(start, end - start);
+
+    for (p = content.c_str(); *p != '\0'; p = next) {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n' ||
+               *p == ',')
+            p++;
+        if (*p == '\0')
+            break;
+        byte = strtoul(p, &next, 0);
+        if (next == p || byte > 0xFF)
+            return -1;
+        der.push_back(static_cast<unsigned char>(byte));
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<unsigned char> pem_der, array_der;
+    size_t i;
+
+    if (argc != 4) {
+        fprintf(stderr, "usage: %s <PEM file> <source file> <array name>\n",
+                argv[0]);
+        return 2;
+    }
+
+    std::ifstream pem(argv[1]);
+    if (!pem) {
+        fprintf(stderr, "Failed to open %s\n", argv[1]);
+        return 2;
+    }
+    if (decode_pem(pem, pem_der) != 0) {
+        printf("FAIL: no valid certificate in %s\n", argv[1]);
+        return 1;
+    }
+
+    std::ifstream source(argv[2]);
+    if (!source) {
+        fprintf(stderr, "Failed to open %s\n", argv[2]);
+        return 2;
+    }
+    if (read_array(source, argv[3], array_der) != 0) {
+        printf("FAIL: no valid array %s in %s\n", argv[3], argv[2]);
+        return 1;
+    }
+
+    for (i = 0; i < pem_der.size() && i < array_der.size(); i++) {
+        if (pem_der[i] != array_der[i])
+            break;
+    }
+    if (i < pem_der.size() || i < array_der.size()) {
+        printf("FAIL: %s differs from %s at byte %zu (%zu and %zu bytes)\n",
+               argv[3], argv[1], i, array_der.size(), pem_der.size());
+        return 1;
+    }
+
+    printf("PASS: %s matches %s (%zu bytes)\n", argv[3], argv[1],
+           array_der.size());
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ *  Match the output of an example against its templated log
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/**
+ * \file check_log.cpp
+ *
+ * \brief Host equivalent of the htrun log comparison described in
+ *        tests/README.md
+ *
+ * Usage: check_log <template log> <example> [arguments...]
+ *
+ * The example is run with its output echoed to stdout. Each line of the
+ * template is a regular expression; the lines must match the output in order,
+ * skipping any output lines in between. The example must also exit with
+ * status 0, so that a crash after the expected output is not a pass.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <regex>
+#include <string>
+#include <vector>
+
+static void strip_cr(std::string &line)
+{
+    if (!line.empty() && line[line.size() - 1] == '\r')
+        line.erase(line.size() - 1);
+}
+
+/*
+ * Return 1 if the line matches the next pattern that has not been matched yet
+ */
+static size_t match_line(std::string &line,
+                         const std::vector<std::regex> &patterns,
+                         size_t matched)
+{
+    strip_cr(line);
+
+    if (matched < patterns.size() &&
+        std::regex_search(line, patterns[matched])) {
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::regex> patterns;
+    std::vector<std::string> sources;
+    std::string line;
+    size_t matched = 0;
+    int fds[2];
+    pid_t pid;
+    int status;
+    FILE *output;
+    char chunk[512];
+
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <template log> <example> [args...]\n",
+                argv[0]);
+        return 2;
+    }
+
+    std::ifstream log(argv[1]);
+    if (!log) {
+        fprintf(stderr, "Failed to open %s\n", argv[1]);
+        return 2;
+    }
+    while (std::getline(log, line)) {
+        strip_cr(line);
+        if (line.empty())
+            continue;
+        patterns.push_back(std::regex(line));
+        sources.push_back(line);
+    }
+
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        return 2;
+    }
+
+    pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return 2;
+    } else if (pid == 0) {
+        dup2(fds[1], STDOUT_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+        execv(argv[2], &argv[2]);
+        fprintf(stderr, "Failed to run %s: %s\n", argv[2], strerror(errno));
+        _exit(127);
+    }
+    close(fds[1]);
+
+    output = fdopen(fds[0], "r");
+    line.clear();
+    while (fgets(chunk, sizeof(chunk), output) != NULL) {
+        fputs(chunk, stdout);
+        line += chunk;
+        if (line[line.size() - 1] != '\n')
+            continue;
+
+        line.erase(line.size() - 1);
+        matched += match_line(line, patterns, matched);
+        line.clear();
+    }
+    if (!line.empty())
+        matched += match_line(line, patterns, matched);
+    fclose(output);
+    if (waitpid(pid, &status, 0) < 0) {
+        perror("waitpid");
+        return 2;
+    }
+
+    if (matched < patterns.size()) {
+        printf("\nFAIL: no output line matched '%s'\n",
+               sources[matched].c_str());
+        return 1;
+    }
+
+    if (WIFSIGNALED(status)) {
+        printf("\nFAIL: %s was killed by signal %d\n", argv[2],
+               WTERMSIG(status));
+        return 1;
+    } else if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        printf("\nFAIL: %s exited with status %d\n", argv[2],
+               WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+        return 1;
+    }
+
+    printf("\nPASS: %zu template lines matched\n", patterns.size());
+
+    return 0;
+}
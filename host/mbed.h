@@ -0,0 +1,61 @@
+/*
+ *  Host (POSIX) replacement for the Mbed OS umbrella header
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/**
+ * \file mbed.h
+ *
+ * \brief Thin shim that lets the examples build as Linux executables
+ *
+ * Only the parts of Mbed OS used by the examples are provided: Timer,
+ * Timeout, Kernel, ThisThread, NetworkInterface and TCPSocket.
+ * mbedtls_platform_setup() and mbedtls_platform_teardown() come from the
+ * default implementation in Mbed TLS itself.
+ *
+ * Do not include system headers such as <unistd.h> here: the examples
+ * define static helpers whose names may clash with POSIX.
+ */
+
+#ifndef MBED_H
+#define MBED_H
+
+#include <new>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Timer.h"
+#include "Timeout.h"
+#include "Kernel.h"
+#include "ThisThread.h"
+#include "NetworkInterface.h"
+#include "TCPSocket.h"
+
+#ifndef MBED_NOINLINE
+#define MBED_NOINLINE   __attribute__((noinline))
+#endif
+
+#ifndef MBED_UNUSED
+#define MBED_UNUSED     __attribute__((__unused__))
+#endif
+
+using namespace mbed;
+using namespace rtos;
+
+#endif /* MBED_H */
@@ -0,0 +1,51 @@
+/*
+ *  Host (POSIX) shim for the Mbed OS network socket types
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef _NSAPI_TYPES_H_
+#define _NSAPI_TYPES_H_
+
+#include <stdint.h>
+
+/**
+ * Error codes returned by the socket API. The values match the ones used by
+ * Mbed OS so that the examples print the same diagnostics on both platforms.
+ */
+enum nsapi_error {
+    NSAPI_ERROR_OK                  =  0,
+    NSAPI_ERROR_WOULD_BLOCK         = -3001,
+    NSAPI_ERROR_UNSUPPORTED         = -3002,
+    NSAPI_ERROR_PARAMETER           = -3003,
+    NSAPI_ERROR_NO_CONNECTION       = -3004,
+    NSAPI_ERROR_NO_SOCKET           = -3005,
+    NSAPI_ERROR_NO_ADDRESS          = -3006,
+    NSAPI_ERROR_NO_MEMORY           = -3007,
+    NSAPI_ERROR_DNS_FAILURE         = -3009,
+    NSAPI_ERROR_DEVICE_ERROR        = -3012,
+    NSAPI_ERROR_IN_PROGRESS         = -3013,
+    NSAPI_ERROR_ALREADY             = -3014,
+    NSAPI_ERROR_IS_CONNECTED        = -3015,
+    NSAPI_ERROR_CONNECTION_LOST     = -3016,
+    NSAPI_ERROR_CONNECTION_TIMEOUT  = -3017,
+};
+
+typedef int nsapi_error_t;
+typedef unsigned int nsapi_size_t;
+typedef signed int nsapi_size_or_error_t;
+
+#endif /* _NSAPI_TYPES_H_ */
@@ -0,0 +1,300 @@
+/*
+ *  Host tests of the incremental HTTP response parser of tls-client
+ *
+ *  Copyright (C) 2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/**
+ * \file http_parser.cpp
+ *
+ * \brief Feed HttpParser with valid and adversarial responses split at every
+ *        position, as the TLS records may split them
+ *
+ * Each case is parsed whole, in two pieces cut at every offset, and one byte
+ * at a time after every offset. Every way of splitting it must give the same
+ * result as the case expects. The output is checked against
+ * tests/http-parser.log.
+ */
+
+#include "HttpParser.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+
+/**
+ * A response to parse and the expected outcome
+ */
+typedef struct {
+    const char *name;           /**< Printed with the result */
+    const char *input;          /**< The bytes received */
+    bool close;                 /**< Whether the connection closes after them */
+    int ret;                    /**< Expected value of parse() or finish() */
+    int status;                 /**< Expected status code */
+    const char *body;           /**< Expected body */
+    size_t left;                /**< Expected bytes left for the next response */
+    bool keep_alive;            /**< Expected keepAlive() */
+} TestCase;
+
+/**
+ * The outcome of parsing a response
+ */
+typedef struct {
+    int ret;
+    int status;
+    std::string body;
+    size_t consumed;
+    bool done;
+    bool keep_alive;
+} Outcome;
+
+static const TestCase TEST_CASES[] = {
+    {
+        "Content-Length",
+        "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhelloHTTP",
+        false, 0, 200, "hello", 4, true
+    },
+    {
+        "Content-Length: 0",
+        "HTTP/1.1 200 OK\r\ncontent-length:0\r\n\r\nHTTP",
+        false, 0, 200, "", 4, true
+    },
+    {
+        "Chunk extensions and trailers",
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+        "5;name=value\r\nhello\r\n7 ; ext\r\n, world\r\n"
+        "0;last\r\nX-Trailer: yes\r\nX-Other: 1\r\n\r\nHTTP",
+        false, 0, 200, "hello, world", 4, true
+    },
+    {
+        "Chunks over Content-Length",
+        "HTTP/1.1 200 OK\r\nContent-Length: 3\r\n"
+        "Transfer-Encoding: chunked\r\n\r\nA\r\n0123456789\r\n0\r\n\r\n",
+        false, 0, 200, "0123456789", 0, true
+    },
+    {
+        "1xx responses",
+        "\r\nHTTP/1.1 100 Continue\r\n\r\n"
+        "HTTP/1.1 103 Early Hints\r\nLink: </style.css>\r\n\r\n"
+        "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok",
+        false, 0, 200, "ok", 0, true
+    },
+    {
+        "204 without a body",
+        "HTTP/1.1 204 No Content\r\nContent-Length: 10\r\n\r\nHTTP/1.1",
+        false, 0, 204, "", 8, true
+    },
+    {
+        "304 without a body",
+        "HTTP/1.1 304 Not Modified\r\nTransfer-Encoding: chunked\r\n\r\n"
+        "HTTP/1.1",
+        false, 0, 304, "", 8, true
+    },
+    {
+        "Body until close",
+        "HTTP/1.1 200 OK\r\nConnection: keep-alive\r\n\r\nhello world",
+        true, 0, 200, "hello world", 0, false
+    },
+    {
+        "HTTP/1.0 keep-alive",
+        "HTTP/1.0 200 OK\r\nConnection: Keep-Alive\r\nContent-Length: 1\r\n"
+        "\r\nx",
+        false, 0, 200, "x", 0, true
+    },
+    {
+        "Connection: close",
+        "HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: 1\r\n\r\nx",
+        false, 0, 200, "x", 0, false
+    },
+    {
+        "Long header",
+        "HTTP/1.1 200 OK\r\nX-Long: "
+        "0123456789012345678901234567890123456789012345678901234567890123"
+        "0123456789012345678901234567890123456789012345678901234567890123"
+        "\r\nContent-Length: 3\r\n\r\nabc",
+        false, 0, 200, "abc", 0, true
+    },
+    {
+        "Overflowing Content-Length",
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 100000000000000000000000000000000000000\r\n\r\n",
+        false, HTTP_PARSER_ERR_INVALID, 200, "", 0, true
+    },
+    {
+        "Signed Content-Length",
+        "HTTP/1.1 200 OK\r\nContent-Length: -1\r\n\r\n",
+        false, HTTP_PARSER_ERR_INVALID, 200, "", 0, true
+    },
+    {
+        "Conflicting Content-Length",
+        "HTTP/1.1 200 OK\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\nab",
+        false, HTTP_PARSER_ERR_INVALID, 200, "", 0, true
+    },
+    {
+        "Bad chunk size",
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n",
+        false, HTTP_PARSER_ERR_INVALID, 200, "", 0, true
+    },
+    {
+        "Overflowing chunk size",
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+        "100000000000000000000000000000000\r\n",
+        false, HTTP_PARSER_ERR_INVALID, 200, "", 0, true
+    },
+    {
+        "Chunk longer than its size",
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+        "3\r\nhello\r\n0\r\n\r\n",
+        false, HTTP_PARSER_ERR_INVALID, 200, "hel", 0, true
+    },
+    {
+        "Bad status line",
+        "HTTP/2 200 OK\r\n\r\n",
+        false, HTTP_PARSER_ERR_INVALID, 0, "", 0, true
+    },
+    {
+        "Truncated body",
+        "HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\nhello",
+        true, HTTP_PARSER_ERR_INVALID, 200, "hello", 0, true
+    },
+    {
+        "Truncated chunks",
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n",
+        true, HTTP_PARSER_ERR_INVALID, 200, "hello", 0, true
+    },
+};
+
+static int append_body(void *ctx, const char *data, size_t len)
+{
+    static_cast<std::string *>(ctx)->append(data, len);
+
+    return 0;
+}
+
+/*
+ * Parse the input in a first piece of the given length, then in pieces of
+ * piece bytes
+ */
+static void parse_split(const TestCase *test, size_t first, size_t piece,
+                        Outcome *outcome)
+{
+    HttpParser parser(append_body, &outcome->body);
+    size_t len = strlen(test->input);
+    size_t offset = 0, size, consumed;
+
+    outcome->ret = 0;
+    outcome->body.clear();
+    outcome->consumed = 0;
+
+    while (offset < len && !parser.done() && outcome->ret == 0) {
+        size = (offset == 0) ? first : piece;
+        if (size > len - offset)
+            size = len - offset;
+
+        outcome->ret = parser.parse(test->input + offset, size, &consumed);
+        outcome->consumed += consumed;
+        offset += size;
+    }
+    if (outcome->ret == 0 && test->close)
+        outcome->ret = parser.finish();
+
+    outcome->status = parser.status();
+    outcome->done = parser.done();
+    outcome->keep_alive = parser.keepAlive();
+}
+
+/*
+ * Check the outcome of one way of splitting the input
+ *
+ * \return  0 if it is the expected one, -1 otherwise
+ */
+static int check_outcome(const TestCase *test, size_t first, size_t piece,
+                         const Outcome *outcome)
+{
+    size_t len = strlen(test->input);
+
+    if (outcome->ret != test->ret)
+        printf("  parse() returned %d instead of %d", outcome->ret, test->ret);
+    else if (outcome->status != test->status)
+        printf("  status %d instead of %d", outcome->status, test->status);
+    else if (outcome->body != test->body)
+        printf("  body \"%s\" instead of \"%s\"", outcome->body.c_str(),
+               test->body);
+    else if (test->ret != 0)
+        return 0;
+    else if (!outcome->done)
+        printf("  the response is not complete");
+    else if (outcome->consumed != len - test->left)
+        printf("  %zu bytes left instead of %zu", len - outcome->consumed,
+               test->left);
+    else if (outcome->keep_alive != test->keep_alive)
+        printf("  keepAlive() is %d instead of %d", outcome->keep_alive,
+               test->keep_alive);
+    else
+        return 0;
+
+    printf(" with a first piece of %zu bytes, then pieces of %zu bytes\n",
+           first, piece);
+
+    return -1;
+}
+
+/*
+ * Run a case with every way of splitting it
+ *
+ * \return  0 if successful, -1 otherwise
+ */
+static int run_case(const TestCase *test)
+{
+    size_t len = strlen(test->input);
+    size_t first;
+    Outcome outcome;
+
+    for (first = 1; first <= len; first++) {
+        parse_split(test, first, len, &outcome);
+        if (check_outcome(test, first, len, &outcome) != 0)
+            return -1;
+
+        parse_split(test, first, 1, &outcome);
+        if (check_outcome(test, first, 1, &outcome) != 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    size_t i;
+    int failed = 0;
+
+    printf("Testing the HTTP response parser\n");
+
+    for (i = 0; i < sizeof(TEST_CASES) / sizeof(TEST_CASES[0]); i++) {
+        if (run_case(&TEST_CASES[i]) == 0) {
+            printf("%s: OK\n", TEST_CASES[i].name);
+        } else {
+            printf("%s: FAILED\n", TEST_CASES[i].name);
+            failed++;
+        }
+    }
+
+    printf(failed == 0 ? "\nDONE\n" : "\nFAIL\n");
+
+    return failed == 0 ? 0 : 1;
+}
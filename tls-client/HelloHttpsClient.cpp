@@ -20,6 +20,7 @@
  */
 
 #include "HelloHttpsClient.h"
+#include "HttpParser.h"
 
 #include "mbedtls/platform.h"
 #include "mbedtls/config.h"
@@ -28,7 +29,9 @@
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/error.h"
 #include "mbedtls/debug.h"
+#include "mbedtls/ecp.h"
 #include "mbedtls/x509.h"
+#include "mbedtls/version.h"
 
 #include <stdint.h>
 #include <string.h>
@@ -39,27 +42,91 @@ const char *HelloHttpsClient::DRBG_PERSONALIZED_STR =
 
 const size_t HelloHttpsClient::ERROR_LOG_BUFFER_LENGTH = 128;
 
-const char *HelloHttpsClient::TLS_PEM_CA =
-    "-----BEGIN CERTIFICATE-----\n"
-    "MIIDQTCCAimgAwIBAgITBmyfz5m/jAo54vB4ikPmljZbyjANBgkqhkiG9w0BAQsF\n"
-    "ADA5MQswCQYDVQQGEwJVUzEPMA0GA1UEChMGQW1hem9uMRkwFwYDVQQDExBBbWF6\n"
-    "b24gUm9vdCBDQSAxMB4XDTE1MDUyNjAwMDAwMFoXDTM4MDExNzAwMDAwMFowOTEL\n"
-    "MAkGA1UEBhMCVVMxDzANBgNVBAoTBkFtYXpvbjEZMBcGA1UEAxMQQW1hem9uIFJv\n"
-    "b3QgQ0EgMTCCASIwDQYJKoZIhvcNAQEBBQADggEPADCCAQoCggEBALJ4gHHKeNXj\n"
-    "ca9HgFB0fW7Y14h29Jlo91ghYPl0hAEvrAIthtOgQ3pOsqTQNroBvo3bSMgHFzZM\n"
-    "9O6II8c+6zf1tRn4SWiw3te5djgdYZ6k/oI2peVKVuRF4fn9tBb6dNqcmzU5L/qw\n"
-    "IFAGbHrQgLKm+a/sRxmPUDgH3KKHOVj4utWp+UhnMJbulHheb4mjUcAwhmahRWa6\n"
-    "VOujw5H5SNz/0egwLX0tdHA114gk957EWW67c4cX8jJGKLhD+rcdqsq08p8kDi1L\n"
-    "93FcXmn/6pUCyziKrlA4b9v7LWIbxcceVOF34GfID5yHI9Y/QCB/IIDEgEw+OyQm\n"
-    "jgSubJrIqg0CAwEAAaNCMEAwDwYDVR0TAQH/BAUwAwEB/zAOBgNVHQ8BAf8EBAMC\n"
-    "AYYwHQYDVR0OBBYEFIQYzIU07LwMlJQuCFmcx7IQTgoIMA0GCSqGSIb3DQEBCwUA\n"
-    "A4IBAQCY8jdaQZChGsV2USggNiMOruYou6r4lK5IpDB/G/wkjUu0yKGX9rbxenDI\n"
-    "U5PMCCjjmCXPI6T53iHTfIUJrU6adTrCC2qJeHZERxhlbI1Bjjt/msv0tadQ1wUs\n"
-    "N+gDS63pYaACbvXy8MWy7Vu33PqUXHeeE6V/Uq2V8viTO96LXFvKWlJbYK8U90vv\n"
-    "o/ufQJVtMVT8QtPHRh8jrdkPSHCa2XV4cdFyQzR1bldZwgJcJmApzyMZFo6IQ6XU\n"
-    "5MsI+yMRQ+hDKXJioaldXgjUkK642M4UwtBV8ob2xJNDd2ZhwLnoQdeXeGADbkpy\n"
-    "rqXRfboQnoZsG4q5WTP468SQvvG5\n"
-    "-----END CERTIFICATE-----\n";
+/*
+ * Amazon Root CA 1, which signs the certificate chain of os.mbed.com, in DER
+ * format. The bytes are those of AmazonRootCA1.pem converted with:
+ *   openssl x509 -in AmazonRootCA1.pem -outform der | xxd -i
+ * ctest checks that they still match the PEM file.
+ */
+static const unsigned char AMAZON_ROOT_CA_1_DER[] = {
+    0x30, 0x82, 0x03, 0x41, 0x30, 0x82, 0x02, 0x29, 0xA0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x13, 0x06, 0x6C, 0x9F, 0xCF, 0x99, 0xBF, 0x8C, 0x0A, 0x39,
+    0xE2, 0xF0, 0x78, 0x8A, 0x43, 0xE6, 0x96, 0x36, 0x5B, 0xCA, 0x30, 0x0D,
+    0x06, 0x09, 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x0B, 0x05,
+    0x00, 0x30, 0x39, 0x31, 0x0B, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06,
+    0x13, 0x02, 0x55, 0x53, 0x31, 0x0F, 0x30, 0x0D, 0x06, 0x03, 0x55, 0x04,
+    0x0A, 0x13, 0x06, 0x41, 0x6D, 0x61, 0x7A, 0x6F, 0x6E, 0x31, 0x19, 0x30,
+    0x17, 0x06, 0x03, 0x55, 0x04, 0x03, 0x13, 0x10, 0x41, 0x6D, 0x61, 0x7A,
+    0x6F, 0x6E, 0x20, 0x52, 0x6F, 0x6F, 0x74, 0x20, 0x43, 0x41, 0x20, 0x31,
+    0x30, 0x1E, 0x17, 0x0D, 0x31, 0x35, 0x30, 0x35, 0x32, 0x36, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x5A, 0x17, 0x0D, 0x33, 0x38, 0x30, 0x31, 0x31,
+    0x37, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x5A, 0x30, 0x39, 0x31, 0x0B,
+    0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x31,
+    0x0F, 0x30, 0x0D, 0x06, 0x03, 0x55, 0x04, 0x0A, 0x13, 0x06, 0x41, 0x6D,
+    0x61, 0x7A, 0x6F, 0x6E, 0x31, 0x19, 0x30, 0x17, 0x06, 0x03, 0x55, 0x04,
+    0x03, 0x13, 0x10, 0x41, 0x6D, 0x61, 0x7A, 0x6F, 0x6E, 0x20, 0x52, 0x6F,
+    0x6F, 0x74, 0x20, 0x43, 0x41, 0x20, 0x31, 0x30, 0x82, 0x01, 0x22, 0x30,
+    0x0D, 0x06, 0x09, 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x01,
+    0x05, 0x00, 0x03, 0x82, 0x01, 0x0F, 0x00, 0x30, 0x82, 0x01, 0x0A, 0x02,
+    0x82, 0x01, 0x01, 0x00, 0xB2, 0x78, 0x80, 0x71, 0xCA, 0x78, 0xD5, 0xE3,
+    0x71, 0xAF, 0x47, 0x80, 0x50, 0x74, 0x7D, 0x6E, 0xD8, 0xD7, 0x88, 0x76,
+    0xF4, 0x99, 0x68, 0xF7, 0x58, 0x21, 0x60, 0xF9, 0x74, 0x84, 0x01, 0x2F,
+    0xAC, 0x02, 0x2D, 0x86, 0xD3, 0xA0, 0x43, 0x7A, 0x4E, 0xB2, 0xA4, 0xD0,
+    0x36, 0xBA, 0x01, 0xBE, 0x8D, 0xDB, 0x48, 0xC8, 0x07, 0x17, 0x36, 0x4C,
+    0xF4, 0xEE, 0x88, 0x23, 0xC7, 0x3E, 0xEB, 0x37, 0xF5, 0xB5, 0x19, 0xF8,
+    0x49, 0x68, 0xB0, 0xDE, 0xD7, 0xB9, 0x76, 0x38, 0x1D, 0x61, 0x9E, 0xA4,
+    0xFE, 0x82, 0x36, 0xA5, 0xE5, 0x4A, 0x56, 0xE4, 0x45, 0xE1, 0xF9, 0xFD,
+    0xB4, 0x16, 0xFA, 0x74, 0xDA, 0x9C, 0x9B, 0x35, 0x39, 0x2F, 0xFA, 0xB0,
+    0x20, 0x50, 0x06, 0x6C, 0x7A, 0xD0, 0x80, 0xB2, 0xA6, 0xF9, 0xAF, 0xEC,
+    0x47, 0x19, 0x8F, 0x50, 0x38, 0x07, 0xDC, 0xA2, 0x87, 0x39, 0x58, 0xF8,
+    0xBA, 0xD5, 0xA9, 0xF9, 0x48, 0x67, 0x30, 0x96, 0xEE, 0x94, 0x78, 0x5E,
+    0x6F, 0x89, 0xA3, 0x51, 0xC0, 0x30, 0x86, 0x66, 0xA1, 0x45, 0x66, 0xBA,
+    0x54, 0xEB, 0xA3, 0xC3, 0x91, 0xF9, 0x48, 0xDC, 0xFF, 0xD1, 0xE8, 0x30,
+    0x2D, 0x7D, 0x2D, 0x74, 0x70, 0x35, 0xD7, 0x88, 0x24, 0xF7, 0x9E, 0xC4,
+    0x59, 0x6E, 0xBB, 0x73, 0x87, 0x17, 0xF2, 0x32, 0x46, 0x28, 0xB8, 0x43,
+    0xFA, 0xB7, 0x1D, 0xAA, 0xCA, 0xB4, 0xF2, 0x9F, 0x24, 0x0E, 0x2D, 0x4B,
+    0xF7, 0x71, 0x5C, 0x5E, 0x69, 0xFF, 0xEA, 0x95, 0x02, 0xCB, 0x38, 0x8A,
+    0xAE, 0x50, 0x38, 0x6F, 0xDB, 0xFB, 0x2D, 0x62, 0x1B, 0xC5, 0xC7, 0x1E,
+    0x54, 0xE1, 0x77, 0xE0, 0x67, 0xC8, 0x0F, 0x9C, 0x87, 0x23, 0xD6, 0x3F,
+    0x40, 0x20, 0x7F, 0x20, 0x80, 0xC4, 0x80, 0x4C, 0x3E, 0x3B, 0x24, 0x26,
+    0x8E, 0x04, 0xAE, 0x6C, 0x9A, 0xC8, 0xAA, 0x0D, 0x02, 0x03, 0x01, 0x00,
+    0x01, 0xA3, 0x42, 0x30, 0x40, 0x30, 0x0F, 0x06, 0x03, 0x55, 0x1D, 0x13,
+    0x01, 0x01, 0xFF, 0x04, 0x05, 0x30, 0x03, 0x01, 0x01, 0xFF, 0x30, 0x0E,
+    0x06, 0x03, 0x55, 0x1D, 0x0F, 0x01, 0x01, 0xFF, 0x04, 0x04, 0x03, 0x02,
+    0x01, 0x86, 0x30, 0x1D, 0x06, 0x03, 0x55, 0x1D, 0x0E, 0x04, 0x16, 0x04,
+    0x14, 0x84, 0x18, 0xCC, 0x85, 0x34, 0xEC, 0xBC, 0x0C, 0x94, 0x94, 0x2E,
+    0x08, 0x59, 0x9C, 0xC7, 0xB2, 0x10, 0x4E, 0x0A, 0x08, 0x30, 0x0D, 0x06,
+    0x09, 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x0B, 0x05, 0x00,
+    0x03, 0x82, 0x01, 0x01, 0x00, 0x98, 0xF2, 0x37, 0x5A, 0x41, 0x90, 0xA1,
+    0x1A, 0xC5, 0x76, 0x51, 0x28, 0x20, 0x36, 0x23, 0x0E, 0xAE, 0xE6, 0x28,
+    0xBB, 0xAA, 0xF8, 0x94, 0xAE, 0x48, 0xA4, 0x30, 0x7F, 0x1B, 0xFC, 0x24,
+    0x8D, 0x4B, 0xB4, 0xC8, 0xA1, 0x97, 0xF6, 0xB6, 0xF1, 0x7A, 0x70, 0xC8,
+    0x53, 0x93, 0xCC, 0x08, 0x28, 0xE3, 0x98, 0x25, 0xCF, 0x23, 0xA4, 0xF9,
+    0xDE, 0x21, 0xD3, 0x7C, 0x85, 0x09, 0xAD, 0x4E, 0x9A, 0x75, 0x3A, 0xC2,
+    0x0B, 0x6A, 0x89, 0x78, 0x76, 0x44, 0x47, 0x18, 0x65, 0x6C, 0x8D, 0x41,
+    0x8E, 0x3B, 0x7F, 0x9A, 0xCB, 0xF4, 0xB5, 0xA7, 0x50, 0xD7, 0x05, 0x2C,
+    0x37, 0xE8, 0x03, 0x4B, 0xAD, 0xE9, 0x61, 0xA0, 0x02, 0x6E, 0xF5, 0xF2,
+    0xF0, 0xC5, 0xB2, 0xED, 0x5B, 0xB7, 0xDC, 0xFA, 0x94, 0x5C, 0x77, 0x9E,
+    0x13, 0xA5, 0x7F, 0x52, 0xAD, 0x95, 0xF2, 0xF8, 0x93, 0x3B, 0xDE, 0x8B,
+    0x5C, 0x5B, 0xCA, 0x5A, 0x52, 0x5B, 0x60, 0xAF, 0x14, 0xF7, 0x4B, 0xEF,
+    0xA3, 0xFB, 0x9F, 0x40, 0x95, 0x6D, 0x31, 0x54, 0xFC, 0x42, 0xD3, 0xC7,
+    0x46, 0x1F, 0x23, 0xAD, 0xD9, 0x0F, 0x48, 0x70, 0x9A, 0xD9, 0x75, 0x78,
+    0x71, 0xD1, 0x72, 0x43, 0x34, 0x75, 0x6E, 0x57, 0x59, 0xC2, 0x02, 0x5C,
+    0x26, 0x60, 0x29, 0xCF, 0x23, 0x19, 0x16, 0x8E, 0x88, 0x43, 0xA5, 0xD4,
+    0xE4, 0xCB, 0x08, 0xFB, 0x23, 0x11, 0x43, 0xE8, 0x43, 0x29, 0x72, 0x62,
+    0xA1, 0xA9, 0x5D, 0x5E, 0x08, 0xD4, 0x90, 0xAE, 0xB8, 0xD8, 0xCE, 0x14,
+    0xC2, 0xD0, 0x55, 0xF2, 0x86, 0xF6, 0xC4, 0x93, 0x43, 0x77, 0x66, 0x61,
+    0xC0, 0xB9, 0xE8, 0x41, 0xD7, 0x97, 0x78, 0x60, 0x03, 0x6E, 0x4A, 0x72,
+    0xAE, 0xA5, 0xD1, 0x7D, 0xBA, 0x10, 0x9E, 0x86, 0x6C, 0x1B, 0x8A, 0xB9,
+    0x59, 0x33, 0xF8, 0xEB, 0xC4, 0x90, 0xBE, 0xF1, 0xB9
+};
+
+const HelloHttpsClient::TrustAnchor HelloHttpsClient::TLS_DER_CAS[] = {
+    { AMAZON_ROOT_CA_1_DER, sizeof(AMAZON_ROOT_CA_1_DER) },
+};
+
+const size_t HelloHttpsClient::TLS_DER_CAS_COUNT =
+                                sizeof(TLS_DER_CAS) / sizeof(TLS_DER_CAS[0]);
 
 const char *HelloHttpsClient::HTTP_REQUEST_FILE_PATH =
                                     "/media/uploads/mbed_official/hello.txt";
@@ -70,8 +137,14 @@ const char *HelloHttpsClient::HTTP_OK_STR = "200 OK";
 
 HelloHttpsClient::HelloHttpsClient(const char *in_server_name,
                                    const char *in_server_addr,
-                                   const uint16_t in_server_port) :
-    socket(),
+                                   const uint16_t in_server_port,
+                                   Transport *in_transport) :
+    transport(in_transport),
+    tls_configured(false),
+    chain_verified(false),
+    connected(false),
+    buffered(0),
+    connections(0),
     server_name(in_server_name),
     server_addr(in_server_addr),
     server_port(in_server_port)
@@ -81,6 +154,9 @@ HelloHttpsClient::HelloHttpsClient(const char *in_server_name,
     mbedtls_x509_crt_init(&cacert);
     mbedtls_ssl_init(&ssl);
     mbedtls_ssl_config_init(&ssl_conf);
+
+    extra_ca.der = NULL;
+    extra_ca.len = 0;
 }
 
 HelloHttpsClient::~HelloHttpsClient()
@@ -91,80 +167,226 @@ HelloHttpsClient::~HelloHttpsClient()
     mbedtls_ssl_free(&ssl);
     mbedtls_ssl_config_free(&ssl_conf);
 
-    socket.close();
+    transport->close();
+}
+
+void HelloHttpsClient::addTrustedCa(const unsigned char *der, size_t len)
+{
+    extra_ca.der = der;
+    extra_ca.len = len;
+}
+
+void HelloHttpsClient::setSessionTimeout(uint32_t timeout_s)
+{
+    sessions.setTimeout(timeout_s);
 }
 
 int HelloHttpsClient::run()
 {
     int ret;
-    size_t req_len, req_offset, resp_offset;
-    uint32_t flags;
-    bool resp_200, resp_hello;
-
-    /* Configure the TCPSocket */
-    if ((ret = configureTCPSocket()) != 0)
+    size_t i;
+    const char *paths[HELLO_HTTPS_CLIENT_PIPELINE_DEPTH];
+    unsigned int first_connection;
+    ResponseCheck check;
+    PipelineCount count;
+
+    /* Fetch the file and check the response */
+    check.preview_len = 0;
+    check.matched = 0;
+    check.body_len = 0;
+    ret = fetch(&HTTP_REQUEST_FILE_PATH, 1, checkBody, checkResponse, &check);
+    if (ret != 0)
         return ret;
 
-    /* Configure already initialized Mbed TLS structures */
-    if ((ret = configureTlsContexts()) != 0)
+    /*
+     * Fetch it again over the same connection, sending the requests back to
+     * back before reading the responses
+     */
+    for (i = 0; i < HELLO_HTTPS_CLIENT_PIPELINE_DEPTH; i++)
+        paths[i] = HTTP_REQUEST_FILE_PATH;
+    count.body_len = check.body_len;
+    count.received = 0;
+    count.chunked = 0;
+    first_connection = connections;
+    ret = fetch(paths, HELLO_HTTPS_CLIENT_PIPELINE_DEPTH, NULL, countResponse,
+                &count);
+    if (ret != 0)
         return ret;
+    mbedtls_printf("HTTP: Received %u pipelined responses in order with %u "
+                   "reconnections\n", count.received,
+                   connections - first_connection);
+    mbedtls_printf("HTTP: %u of them were chunked\n", count.chunked);
 
-    /* Start a connection to the server */
-    if ((ret = socket.connect(server_addr, server_port)) != NSAPI_ERROR_OK) {
-        mbedtls_printf("socket.connect() returned %d\n", ret);
+    /* Close the connection, keeping the TLS session for the next run */
+    close();
+
+    return 0;
+}
+
+int HelloHttpsClient::fetch(const char *const *paths, size_t count,
+                            BodyCallback body_callback,
+                            ResponseCallback callback, void *ctx)
+{
+    int ret = 0;
+    size_t sent = 0, received = 0;
+    unsigned int reconnects = 0;
+    HttpResponse response;
+
+    while (received < count) {
+        if (!connected) {
+            if ((ret = connect()) != 0)
+                return ret;
+
+            /* Send again the requests that were not answered */
+            sent = received;
+        }
+
+        /*
+         * Keep up to HELLO_HTTPS_CLIENT_PIPELINE_DEPTH requests in flight. If
+         * the server stops reading, it may still answer those already sent.
+         */
+        while (sent < count &&
+               sent - received < HELLO_HTTPS_CLIENT_PIPELINE_DEPTH) {
+            if ((ret = sendRequest(paths[sent])) != 0)
+                break;
+            sent++;
+        }
+        if (ret == HELLO_HTTPS_CLIENT_ERR_CONNECTION && sent > received)
+            ret = 0;
+
+        /* The responses come in the order of the requests */
+        if (ret == 0)
+            ret = readResponse(received, body_callback, ctx, &response);
+
+        if (ret == HELLO_HTTPS_CLIENT_ERR_CONNECTION) {
+            close();
+            if (++reconnects > HELLO_HTTPS_CLIENT_MAX_RECONNECTS) {
+                mbedtls_printf("Failed to get a response from %s\n",
+                               server_name);
+                return ret;
+            }
+            mbedtls_printf("The connection to %s was closed, "
+                           "reconnecting\n", server_name);
+
+            /* The body of the response will be received again */
+            if (body_callback != NULL &&
+                (ret = body_callback(ctx, received, NULL, 0)) != 0)
+                return ret;
+            continue;
+        } else if (ret != 0) {
+            close();
+            return ret;
+        }
+
+        ret = callback(ctx, received, &response);
+        received++;
+        reconnects = 0;
+
+        if (ret != 0 || !response.keep_alive)
+            close();
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+int HelloHttpsClient::connect()
+{
+    int ret;
+    uint32_t flags;
+    unsigned int ecc_pauses;
+    int call_us, longest_call_us;
+    Timer timer, handshake_timer;
+
+    /*
+     * Configure already initialized Mbed TLS structures the first time, and
+     * reset the TLS context for a new connection afterwards
+     */
+    if (!tls_configured) {
+        if ((ret = configureTlsContexts()) != 0)
+            return ret;
+        tls_configured = true;
+    } else if ((ret = mbedtls_ssl_session_reset(&ssl)) != 0) {
+        mbedtls_printf("mbedtls_ssl_session_reset() returned -0x%04X\n",
+                       -ret);
         return ret;
     }
+
+    /* Start a connection to the server */
+    if ((ret = transport->connect(server_addr, server_port)) != 0)
+        return abortConnect(ret);
     mbedtls_printf("Successfully connected to %s at port %u\n",
                    server_addr, server_port);
 
-    /* Start the TLS handshake */
+    /* Offer the session of a previous connection to the server, if any */
+    if ((ret = sessions.load(server_name, server_port, &ssl)) < 0)
+        return abortConnect(ret);
+    if (ret == 1)
+        mbedtls_printf("Resuming the previous TLS session\n");
+
+    /*
+     * Start the TLS handshake. It returns whenever it has to wait for the
+     * network, and resumes when the transport is ready. With restartable ECC,
+     * it also returns after each HELLO_HTTPS_CLIENT_ECP_MAX_OPS basic ECC
+     * operations, and the other threads run before it is resumed.
+     */
     mbedtls_printf("Starting the TLS handshake...\n");
-    do {
+    ecc_pauses = 0;
+    longest_call_us = 0;
+    chain_verified = false;
+    handshake_timer.start();
+    for (;;) {
+        timer.reset();
+        timer.start();
         ret = mbedtls_ssl_handshake(&ssl);
-    } while(ret != 0 &&
-            (ret == MBEDTLS_ERR_SSL_WANT_READ ||
-            ret == MBEDTLS_ERR_SSL_WANT_WRITE));
+        timer.stop();
+
+        call_us = timer.read_us();
+        if (call_us > longest_call_us)
+            longest_call_us = call_us;
+
+        if (ret == MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS) {
+            ecc_pauses++;
+            ThisThread::yield();
+        } else if (ret == MBEDTLS_ERR_SSL_WANT_READ ||
+                   ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
+            if ((ret = waitForTransport(ret)) != 0)
+                break;
+        } else {
+            break;
+        }
+    }
+    handshake_timer.stop();
     if (ret < 0) {
         mbedtls_printf("mbedtls_ssl_handshake() returned -0x%04X\n", -ret);
-        return ret;
+        sessions.remove(server_name, server_port);
+        return abortConnect(ret);
     }
     mbedtls_printf("Successfully completed the TLS handshake\n");
+    mbedtls_printf("%s in %d ms\n", chain_verified ?
+                   "Negotiated a new TLS session" :
+                   "Resumed the previous TLS session",
+                   handshake_timer.read_ms());
+    mbedtls_printf("The handshake paused %u times for the ECC operations "
+                   "and ran for at most %d ms at a time\n", ecc_pauses,
+                   longest_call_us / 1000);
 
-    /* Fill the request buffer */
-    ret = snprintf(gp_buf, sizeof(gp_buf),
-                   "GET %s HTTP/1.1\r\nHost: %s\r\n\r\n", HTTP_REQUEST_FILE_PATH,
-                   server_name);
-    req_len = static_cast<size_t>(ret);
-    if (ret < 0 || req_len >= sizeof(gp_buf)) {
-        mbedtls_printf("Failed to compose HTTP request using snprintf: %d\n",
-                       ret);
-        return ret;
-    }
-
-    /* Send the HTTP request to the server over TLS */
-    req_offset = 0;
-    do {
-        ret = mbedtls_ssl_write(&ssl,
-                reinterpret_cast<const unsigned char *>(gp_buf + req_offset),
-                req_len - req_offset);
-        if (ret > 0)
-            req_offset += static_cast<size_t>(ret);
-    }
-    while(req_offset < req_len &&
-          (ret > 0 ||
-          ret == MBEDTLS_ERR_SSL_WANT_WRITE ||
-          ret == MBEDTLS_ERR_SSL_WANT_READ));
-    if (ret < 0) {
-        mbedtls_printf("mbedtls_ssl_write() returned -0x%04X\n", -ret);
-        return ret;
-    }
+    /*
+     * Keep the session to resume it in the next connection. The handshake
+     * fails unless the chain verifies, so only a full handshake starts a new
+     * lifetime for the session.
+     */
+    if ((ret = sessions.save(server_name, server_port, &ssl,
+                             chain_verified)) != 0)
+        return abortConnect(ret);
 
     /* Print information about the TLS connection */
     ret = mbedtls_x509_crt_info(gp_buf, sizeof(gp_buf),
                                 "\r  ", mbedtls_ssl_get_peer_cert(&ssl));
     if (ret < 0) {
         mbedtls_printf("mbedtls_x509_crt_info() returned -0x%04X\n", -ret);
-        return ret;
+        return abortConnect(ret);
     }
     mbedtls_printf("Server certificate:\n%s\n", gp_buf);
 
@@ -176,11 +398,12 @@ int HelloHttpsClient::run()
         if (ret < 0) {
             mbedtls_printf("mbedtls_x509_crt_verify_info() returned "
                            "-0x%04X\n", -ret);
-            return ret;
+            return abortConnect(ret);
         } else {
             mbedtls_printf("Certificate verification failed (flags %lu):"
-                           "\n%s\n", flags, gp_buf);
-            return -1;
+                           "\n%s\n", static_cast<unsigned long>(flags),
+                           gp_buf);
+            return abortConnect(-1);
         }
     } else {
         mbedtls_printf("Certificate verification passed\n");
@@ -188,61 +411,241 @@ int HelloHttpsClient::run()
 
     mbedtls_printf("Established TLS connection to %s\n", server_name);
 
-    /* Read response from the server */
-    resp_offset = 0;
-    resp_200 = false;
-    resp_hello = false;
-    do {
-        ret = mbedtls_ssl_read(&ssl,
-                    reinterpret_cast<unsigned char *>(gp_buf  + resp_offset),
-                    sizeof(gp_buf) - resp_offset - 1);
-        if (ret > 0)
-            resp_offset += static_cast<size_t>(ret);
+    connected = true;
+    buffered = 0;
+    connections++;
 
-        /* Ensure that the response string is null-terminated */
-        gp_buf[resp_offset] = '\0';
+    return 0;
+}
 
-        /* Check  if we received expected string */
-        resp_200 = resp_200 || strstr(gp_buf, HTTP_OK_STR) != NULL;
-        resp_hello = resp_hello || strstr(gp_buf, HTTP_HELLO_STR) != NULL;
-    } while((!resp_200 || !resp_hello) &&
-            (ret > 0 ||
-            ret == MBEDTLS_ERR_SSL_WANT_READ || MBEDTLS_ERR_SSL_WANT_WRITE));
-    if (ret < 0) {
-        mbedtls_printf("mbedtls_ssl_read() returned -0x%04X\n", -ret);
-        return ret;
+int HelloHttpsClient::abortConnect(int ret)
+{
+    int reset_ret;
+
+    transport->close();
+
+    if ((reset_ret = mbedtls_ssl_session_reset(&ssl)) != 0)
+        mbedtls_printf("mbedtls_ssl_session_reset() returned -0x%04X\n",
+                       -reset_ret);
+
+    return ret;
+}
+
+int HelloHttpsClient::sendRequest(const char *path)
+{
+    int ret;
+    size_t req_len, req_offset;
+
+    /* Fill the request buffer */
+    ret = snprintf(req_buf, sizeof(req_buf),
+                   "GET %s HTTP/1.1\r\nHost: %s\r\n\r\n", path, server_name);
+    if (ret < 0 || static_cast<size_t>(ret) >= sizeof(req_buf)) {
+        mbedtls_printf("Failed to compose HTTP request using snprintf: %d\n",
+                       ret);
+        return -1;
     }
+    req_len = static_cast<size_t>(ret);
 
-    /* Display response information */
-    mbedtls_printf("HTTP: Received %u chars from server\n", resp_offset);
-    mbedtls_printf("HTTP: Received '%s' status ... %s\n", HTTP_OK_STR,
-                   resp_200 ? "OK" : "FAIL");
-    mbedtls_printf("HTTP: Received message:\n%s\n", gp_buf);
+    /* Send the HTTP request to the server over TLS */
+    req_offset = 0;
+    while (req_offset < req_len) {
+        ret = mbedtls_ssl_write(&ssl,
+                reinterpret_cast<const unsigned char *>(req_buf + req_offset),
+                req_len - req_offset);
+        if (ret > 0)
+            req_offset += static_cast<size_t>(ret);
+        else if (ret == MBEDTLS_ERR_SSL_WANT_WRITE ||
+                 ret == MBEDTLS_ERR_SSL_WANT_READ)
+            ret = waitForTransport(ret);
+
+        if (ret < 0)
+            break;
+    }
+    if (ret < 0) {
+        mbedtls_printf("mbedtls_ssl_write() returned -0x%04X\n", -ret);
+        return HELLO_HTTPS_CLIENT_ERR_CONNECTION;
+    }
 
     return 0;
 }
 
-int HelloHttpsClient::configureTCPSocket()
+int HelloHttpsClient::receive()
 {
     int ret;
 
-    NetworkInterface *network = NetworkInterface::get_default_instance();
-    if(network == NULL) {
-        mbedtls_printf("ERROR: No network interface found!\n");
-        return -1;
+    for (;;) {
+        ret = mbedtls_ssl_read(&ssl,
+                    reinterpret_cast<unsigned char *>(gp_buf + buffered),
+                    sizeof(gp_buf) - buffered);
+        if (ret != MBEDTLS_ERR_SSL_WANT_READ &&
+            ret != MBEDTLS_ERR_SSL_WANT_WRITE)
+            break;
+        if ((ret = waitForTransport(ret)) != 0)
+            break;
     }
-    ret = network->connect();
-    if (ret != 0) {
-        mbedtls_printf("Error! network->connect() returned: %d\n", ret);
-        return ret;
+
+    if (ret > 0) {
+        buffered += static_cast<size_t>(ret);
+        return 0;
     }
 
-    if ((ret = socket.open(network)) != NSAPI_ERROR_OK) {
-        mbedtls_printf("socket.open() returned %d\n", ret);
-        return ret;
+    /* The server closed the connection */
+    if (ret != 0 && ret != MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY)
+        mbedtls_printf("mbedtls_ssl_read() returned -0x%04X\n", -ret);
+
+    return HELLO_HTTPS_CLIENT_ERR_CONNECTION;
+}
+
+int HelloHttpsClient::readResponse(size_t index, BodyCallback body_callback,
+                                   void *ctx, HttpResponse *response)
+{
+    int ret;
+    size_t consumed;
+    BodyContext body = { body_callback, ctx, index };
+    HttpParser parser(deliverBody, &body);
+
+    while (!parser.done()) {
+        /* Parse the bytes left after the previous response first */
+        if (buffered == 0) {
+            ret = receive();
+            if (ret == HELLO_HTTPS_CLIENT_ERR_CONNECTION &&
+                parser.received() > 0 && parser.finish() == 0)
+                break;
+            else if (ret != 0)
+                return ret;
+        }
+
+        ret = parser.parse(gp_buf, buffered, &consumed);
+
+        /* Keep the start of the next response, if already received */
+        buffered -= consumed;
+        memmove(gp_buf, gp_buf + consumed, buffered);
+
+        if (ret == HTTP_PARSER_ERR_INVALID) {
+            mbedtls_printf("HTTP: Invalid response from %s\n", server_name);
+            return HELLO_HTTPS_CLIENT_ERR_RESPONSE;
+        } else if (ret != 0) {
+            return ret;
+        }
     }
 
-    socket.set_blocking(false);
+    response->status = parser.status();
+    response->keep_alive = parser.keepAlive();
+    response->length = parser.received();
+    response->body_len = parser.bodyLength();
+    response->chunked = parser.chunkedBody();
+
+    return 0;
+}
+
+int HelloHttpsClient::deliverBody(void *ctx, const char *data, size_t len)
+{
+    BodyContext *body = static_cast<BodyContext *>(ctx);
+
+    if (body->callback == NULL)
+        return 0;
+
+    return body->callback(body->ctx, body->index, data, len);
+}
+
+/*
+ * Advance the search of str in a stream by one character. matched is the
+ * length of the longest prefix of str that ends the stream so far.
+ */
+static size_t matchNext(const char *str, size_t matched, char c)
+{
+    size_t k;
+
+    for (;;) {
+        if (str[matched] == c)
+            return matched + 1;
+        if (matched == 0)
+            return 0;
+
+        /* Fall back to the longest prefix that is also a suffix */
+        for (k = matched - 1; k > 0; k--) {
+            if (memcmp(str, str + matched - k, k) == 0)
+                break;
+        }
+        matched = k;
+    }
+}
+
+int HelloHttpsClient::checkBody(void *ctx, size_t index, const char *data,
+                                size_t len)
+{
+    ResponseCheck *check = static_cast<ResponseCheck *>(ctx);
+    size_t copy, i;
+
+    (void)index;
+
+    /* Start again after a reconnection */
+    if (data == NULL) {
+        check->preview_len = 0;
+        check->matched = 0;
+        return 0;
+    }
+
+    /* Keep the start of the body to print it */
+    copy = sizeof(check->preview) - check->preview_len;
+    if (copy > len)
+        copy = len;
+    memcpy(check->preview + check->preview_len, data, copy);
+    check->preview_len += copy;
+
+    for (i = 0; i < len && HTTP_HELLO_STR[check->matched] != '\0'; i++)
+        check->matched = matchNext(HTTP_HELLO_STR, check->matched, data[i]);
+
+    return 0;
+}
+
+int HelloHttpsClient::checkResponse(void *ctx, size_t index,
+                                    const HttpResponse *response)
+{
+    ResponseCheck *check = static_cast<ResponseCheck *>(ctx);
+    bool resp_200, resp_hello;
+
+    (void)index;
+
+    resp_200 = response->status == 200;
+    resp_hello = HTTP_HELLO_STR[check->matched] == '\0';
+    check->body_len = response->body_len;
+
+    /* Display response information */
+    mbedtls_printf("HTTP: Received %u chars from server\n",
+                   static_cast<unsigned int>(response->length));
+    mbedtls_printf("HTTP: Received '%s' status ... %s\n", HTTP_OK_STR,
+                   resp_200 ? "OK" : "FAIL");
+    mbedtls_printf("HTTP: Received message:\n%.*s\n",
+                   static_cast<int>(check->preview_len), check->preview);
+    if (response->body_len > check->preview_len)
+        mbedtls_printf("HTTP: ... and %u more chars\n",
+                       static_cast<unsigned int>(response->body_len -
+                                                 check->preview_len));
+
+    return (resp_200 && resp_hello) ? 0 : -1;
+}
+
+int HelloHttpsClient::countResponse(void *ctx, size_t index,
+                                    const HttpResponse *response)
+{
+    PipelineCount *count = static_cast<PipelineCount *>(ctx);
+
+    if (response->status != 200) {
+        mbedtls_printf("HTTP: Response %u has status %d\n",
+                       static_cast<unsigned int>(index), response->status);
+        return -1;
+    }
+    if (response->body_len != count->body_len) {
+        mbedtls_printf("HTTP: Response %u has %u chars of body instead of "
+                       "%u\n", static_cast<unsigned int>(index),
+                       static_cast<unsigned int>(response->body_len),
+                       static_cast<unsigned int>(count->body_len));
+        return -1;
+    }
+    count->received++;
+    if (response->chunked)
+        count->chunked++;
 
     return 0;
 }
@@ -250,6 +653,8 @@ int HelloHttpsClient::configureTCPSocket()
 int HelloHttpsClient::configureTlsContexts()
 {
     int ret;
+    size_t i;
+    const TrustAnchor *ca;
 
     ret = mbedtls_ctr_drbg_seed(&ctr_drbg, mbedtls_entropy_func, &entropy,
             reinterpret_cast<const unsigned char *>(DRBG_PERSONALIZED_STR),
@@ -259,12 +664,25 @@ int HelloHttpsClient::configureTlsContexts()
         return ret;
     }
 
-    ret = mbedtls_x509_crt_parse(&cacert,
-                        reinterpret_cast<const unsigned char *>(TLS_PEM_CA),
-                        strlen(TLS_PEM_CA) + 1);
-    if (ret != 0) {
-        mbedtls_printf("mbedtls_x509_crt_parse() returned -0x%04X\n", -ret);
-        return ret;
+    /*
+     * The trusted CAs are parsed from DER, without decoding base64. Since
+     * Mbed TLS 2.17, cacert points to the arrays in flash instead of copying
+     * them to the heap. The CA given to addTrustedCa() comes last.
+     */
+    for (i = 0; i <= TLS_DER_CAS_COUNT; i++) {
+        ca = (i < TLS_DER_CAS_COUNT) ? &TLS_DER_CAS[i] : &extra_ca;
+        if (ca->der == NULL)
+            continue;
+#if MBEDTLS_VERSION_NUMBER >= 0x02110000
+        ret = mbedtls_x509_crt_parse_der_nocopy(&cacert, ca->der, ca->len);
+#else
+        ret = mbedtls_x509_crt_parse_der(&cacert, ca->der, ca->len);
+#endif /* MBEDTLS_VERSION_NUMBER >= 0x02110000 */
+        if (ret != 0) {
+            mbedtls_printf("mbedtls_x509_crt_parse_der() returned -0x%04X\n",
+                           -ret);
+            return ret;
+        }
     }
 
     ret = mbedtls_ssl_config_defaults(&ssl_conf, MBEDTLS_SSL_IS_CLIENT,
@@ -279,6 +697,14 @@ int HelloHttpsClient::configureTlsContexts()
     mbedtls_ssl_conf_ca_chain(&ssl_conf, &cacert, NULL);
     mbedtls_ssl_conf_rng(&ssl_conf, mbedtls_ctr_drbg_random, &ctr_drbg);
 
+#if defined(MBEDTLS_ECP_RESTARTABLE)
+    /*
+     * Let the handshake return in the middle of the ECC operations. The limit
+     * applies to all the ECC operations of the application.
+     */
+    mbedtls_ecp_set_max_ops(HELLO_HTTPS_CLIENT_ECP_MAX_OPS);
+#endif /* MBEDTLS_ECP_RESTARTABLE */
+
     /*
      * It is possible to disable authentication by passing
      * MBEDTLS_SSL_VERIFY_NONE in the call to mbedtls_ssl_conf_authmode()
@@ -304,38 +730,50 @@ int HelloHttpsClient::configureTlsContexts()
         return ret;
     }
 
-    mbedtls_ssl_set_bio(&ssl, static_cast<void *>(&socket), sslSend, sslRecv,
-                        NULL);
+    mbedtls_ssl_set_bio(&ssl, static_cast<void *>(transport), sslSend,
+                        sslRecv, NULL);
 
     return 0;
 }
 
-int HelloHttpsClient::sslRecv(void *ctx, unsigned char *buf, size_t len)
+void HelloHttpsClient::close()
 {
-    TCPSocket *socket = static_cast<TCPSocket *>(ctx);
-    int ret = socket->recv(buf, len);
+    int ret;
 
-    if (ret == NSAPI_ERROR_WOULD_BLOCK)
-        ret = MBEDTLS_ERR_SSL_WANT_READ;
-    else if (ret < 0)
-        mbedtls_printf("socket.recv() returned %d\n", ret);
+    if (connected) {
+        while ((ret = mbedtls_ssl_close_notify(&ssl)) ==
+               MBEDTLS_ERR_SSL_WANT_WRITE) {
+            if (waitForTransport(ret) != 0)
+                break;
+        }
+    }
 
-    return ret;
+    transport->close();
+    connected = false;
+    buffered = 0;
 }
 
-int HelloHttpsClient::sslSend(void *ctx, const unsigned char *buf, size_t len)
+int HelloHttpsClient::waitForTransport(int want)
 {
-    TCPSocket *socket = static_cast<TCPSocket *>(ctx);
-    int ret = socket->send(buf, len);
+    int ret = transport->wait(want, HELLO_HTTPS_CLIENT_IO_TIMEOUT_MS);
 
-    if (ret == NSAPI_ERROR_WOULD_BLOCK)
-        ret = MBEDTLS_ERR_SSL_WANT_WRITE;
-    else if (ret < 0)
-        mbedtls_printf("socket.send() returned %d\n", ret);
+    if (ret == MBEDTLS_ERR_SSL_TIMEOUT)
+        mbedtls_printf("No data was exchanged with %s for %d ms\n",
+                       server_name, HELLO_HTTPS_CLIENT_IO_TIMEOUT_MS);
 
     return ret;
 }
 
+int HelloHttpsClient::sslRecv(void *ctx, unsigned char *buf, size_t len)
+{
+    return static_cast<Transport *>(ctx)->recv(buf, len);
+}
+
+int HelloHttpsClient::sslSend(void *ctx, const unsigned char *buf, size_t len)
+{
+    return static_cast<Transport *>(ctx)->send(buf, len);
+}
+
 void HelloHttpsClient::sslDebug(void *ctx, int level, const char *file,
                                 int line, const char *str)
 {
@@ -356,6 +794,9 @@ int HelloHttpsClient::sslVerify(void *ctx, mbedtls_x509_crt *crt, int depth,
                                 uint32_t *flags)
 {
     int ret = 0;
+    HelloHttpsClient *client = static_cast<HelloHttpsClient *>(ctx);
+
+    client->chain_verified = true;
 
     /*
      * If MBEDTLS_HAVE_TIME_DATE is defined, then the certificate date and time
@@ -366,8 +807,6 @@ int HelloHttpsClient::sslVerify(void *ctx, mbedtls_x509_crt *crt, int depth,
     *flags &= ~MBEDTLS_X509_BADCERT_FUTURE & ~MBEDTLS_X509_BADCERT_EXPIRED;
 
 #if HELLO_HTTPS_CLIENT_DEBUG_LEVEL > 0
-    HelloHttpsClient *client = static_cast<HelloHttpsClient *>(ctx);
-
     ret = mbedtls_x509_crt_info(client->gp_buf, sizeof(gp_buf), "\r  ", crt);
     if (ret < 0) {
         mbedtls_printf("mbedtls_x509_crt_info() returned -0x%04X\n", -ret);
@@ -22,7 +22,8 @@
 #ifndef _HELLOHTTPSCLIENT_H_
 #define _HELLOHTTPSCLIENT_H_
 
-#include "TCPSocket.h"
+#include "Transport.h"
+#include "SessionCache.h"
 
 #include "mbedtls/config.h"
 #include "mbedtls/ssl.h"
@@ -45,8 +46,67 @@
 #define GENERAL_PURPOSE_BUFFER_LENGTH   1024
 
 /**
- * This class implements the logic for fetching a file from a webserver using
- * a TCP socket and parsing the result.
+ * Maximum number of basic ECC operations that the TLS handshake performs
+ * before returning to HelloHttpsClient::connect() to let the other threads
+ * run, if Mbed TLS is built with MBEDTLS_ECP_RESTARTABLE. 0 computes each ECC
+ * operation in one go.
+ */
+#if defined(MBED_CONF_APP_ECP_MAX_OPS)
+#define HELLO_HTTPS_CLIENT_ECP_MAX_OPS  MBED_CONF_APP_ECP_MAX_OPS
+#else
+#define HELLO_HTTPS_CLIENT_ECP_MAX_OPS  1000
+#endif /* MBED_CONF_APP_ECP_MAX_OPS */
+
+/**
+ * Maximum number of requests sent on a connection before reading their
+ * responses. 1 waits for each response before sending the next request.
+ */
+#if defined(MBED_CONF_APP_PIPELINE_DEPTH)
+#define HELLO_HTTPS_CLIENT_PIPELINE_DEPTH   MBED_CONF_APP_PIPELINE_DEPTH
+#else
+#define HELLO_HTTPS_CLIENT_PIPELINE_DEPTH   4
+#endif /* MBED_CONF_APP_PIPELINE_DEPTH */
+
+/**
+ * Time in milliseconds that the client waits for the network before giving
+ * up on the connection
+ */
+#if defined(MBED_CONF_APP_IO_TIMEOUT)
+#define HELLO_HTTPS_CLIENT_IO_TIMEOUT_MS    MBED_CONF_APP_IO_TIMEOUT
+#else
+#define HELLO_HTTPS_CLIENT_IO_TIMEOUT_MS    30000
+#endif /* MBED_CONF_APP_IO_TIMEOUT */
+
+/**
+ * Number of times that HelloHttpsClient::fetch() reconnects to the server
+ * without receiving a response before giving up
+ */
+#define HELLO_HTTPS_CLIENT_MAX_RECONNECTS   2
+
+/**
+ * Length (in bytes) of the buffer holding each HTTP request
+ */
+#define HTTP_REQUEST_BUFFER_LENGTH      256
+
+/**
+ * Length (in bytes) of the start of the body that HelloHttpsClient::run()
+ * prints
+ */
+#define HTTP_BODY_PREVIEW_LENGTH        128
+
+/**
+ * The connection was closed before the response was received
+ */
+#define HELLO_HTTPS_CLIENT_ERR_CONNECTION   -2
+
+/**
+ * The response is invalid or does not fit in the buffer
+ */
+#define HELLO_HTTPS_CLIENT_ERR_RESPONSE     -3
+
+/**
+ * This class implements the logic for fetching a file from a webserver over
+ * a Transport, usually a TcpTransport, and parsing the result.
  */
 class HelloHttpsClient
 {
@@ -60,10 +120,13 @@ public:
      *              The server domain/IP address
      * \param[in]   in_server_port
      *              The server port
+     * \param[in]   in_transport
+     *              The transport connecting to the server
      */
     HelloHttpsClient(const char *in_server_name,
                      const char *in_server_addr,
-                     const uint16_t in_server_port);
+                     const uint16_t in_server_port,
+                     Transport *in_transport);
 
     /**
      * Free any allocated resources
@@ -71,19 +134,119 @@ public:
     ~HelloHttpsClient();
 
     /**
-     * Start the connection to the server and request to read the file at
-     * HTTP_REQUEST_FILE_PATH
+     * An HTTP response, once its body has been received
+     */
+    typedef struct {
+        int status;             /**< The status code, such as 200 */
+        bool keep_alive;        /**< The connection stays open */
+        size_t length;          /**< Length (in bytes) of the response as
+                                     received, headers included */
+        size_t body_len;        /**< Length (in bytes) of the body, without
+                                     the chunk framing */
+        bool chunked;           /**< The body was sent in chunks */
+    } HttpResponse;
+
+    /**
+     * Callback receiving the body of each response of
+     * HelloHttpsClient::fetch() as it arrives, in pieces of any size. If the
+     * connection is lost in the middle of a response, the callback is called
+     * with data NULL and len 0, and the body is received again from the
+     * start after reconnecting.
+     *
+     * \param[in]   ctx
+     *              The context given to HelloHttpsClient::fetch()
+     * \param[in]   index
+     *              The index of the request in the paths
+     * \param[in]   data
+     *              The next bytes of the body, or NULL
+     * \param[in]   len
+     *              The number of bytes
+     *
+     * \return  0 to continue, another value to stop HelloHttpsClient::fetch()
+     *          and return it
+     */
+    typedef int (*BodyCallback)(void *ctx, size_t index, const char *data,
+                                size_t len);
+
+    /**
+     * Callback called at the end of each response of
+     * HelloHttpsClient::fetch()
+     *
+     * \param[in]   ctx
+     *              The context given to HelloHttpsClient::fetch()
+     * \param[in]   index
+     *              The index of the request in the paths
+     * \param[in]   response
+     *              The response
+     *
+     * \return  0 to continue, another value to stop HelloHttpsClient::fetch()
+     *          and return it
+     */
+    typedef int (*ResponseCallback)(void *ctx, size_t index,
+                                    const HttpResponse *response);
+
+    /**
+     * Trust a CA in addition to those of TLS_DER_CAS, such as the CA of
+     * LocalServer. This must be called before the first connection.
+     *
+     * \param[in]   der
+     *              The certificate in DER format, which must stay in memory
+     *              as long as the client
+     * \param[in]   len
+     *              Length (in bytes) of der
+     */
+    void addTrustedCa(const unsigned char *der, size_t len);
+
+    /**
+     * Set the time (in seconds) after which a negotiated TLS session is no
+     * longer resumed, instead of SESSION_CACHE_TIMEOUT
+     */
+    void setSessionTimeout(uint32_t timeout_s);
+
+    /**
+     * Request to read the file at HTTP_REQUEST_FILE_PATH, first alone and
+     * then in a pipeline of HELLO_HTTPS_CLIENT_PIPELINE_DEPTH requests over
+     * the same connection, then close the connection. The TLS session is
+     * kept, so that the next call resumes it instead of running a full
+     * handshake.
      *
      * \return  0 if successful
      */
     int run();
 
-private:
     /**
-     * Create a TCPSocket object that can be used to communicate with the server
+     * Fetch files from the server, keeping the connection open between the
+     * requests. Up to HELLO_HTTPS_CLIENT_PIPELINE_DEPTH requests are sent
+     * before reading their responses, which the server sends in the same
+     * order. If the server closes the connection, the client reconnects and
+     * sends again the requests that were not answered, so they must be safe
+     * to repeat.
+     *
+     * \param[in]   paths
+     *              The paths of the files
+     * \param[in]   count
+     *              The number of paths
+     * \param[in]   body_callback
+     *              Called with the body of each response, or NULL to discard
+     *              the bodies
+     * \param[in]   callback
+     *              Called at the end of each response, in the order of the
+     *              paths
+     * \param[in]   ctx
+     *              The context of the callbacks
+     *
+     * \return  0 if successful
      */
-    int configureTCPSocket();
+    int fetch(const char *const *paths, size_t count,
+              BodyCallback body_callback, ResponseCallback callback,
+              void *ctx);
 
+    /**
+     * Send a close notification to the server and close the transport
+     */
+    void close();
+
+private:
     /**
      * Configure the Mbed TLS structures required to establish a TLS connection
      * with the server
@@ -91,11 +254,113 @@ private:
     int configureTlsContexts();
 
     /**
-     * Wrapper function around TCPSocket that gets called by Mbed TLS whenever
+     * Connect to the server, resuming the TLS session of the previous
+     * connection if possible
+     *
+     * \return  0 if successful
+     */
+    int connect();
+
+    /**
+     * Close the transport and reset the TLS context after connect() failed,
+     * so that the next attempt does not leak the socket
+     *
+     * \param[in]   ret
+     *              The error to return
+     *
+     * \return  ret
+     */
+    int abortConnect(int ret);
+
+    /**
+     * Send a GET request
+     *
+     * \param[in]   path
+     *              The path of the file
+     *
+     * \return  0 if successful, HELLO_HTTPS_CLIENT_ERR_CONNECTION if the
+     *          connection failed
+     */
+    int sendRequest(const char *path);
+
+    /**
+     * Receive more data in gp_buf after the buffered bytes
+     *
+     * \return  0 if successful, HELLO_HTTPS_CLIENT_ERR_CONNECTION if the
+     *          connection is closed
+     */
+    int receive();
+
+    /**
+     * Receive the next response with HttpParser, which passes the body to
+     * the callback as it arrives, so that gp_buf only holds the bytes of one
+     * read. The bytes of the next response that arrive with the end of this
+     * one are kept at the start of gp_buf.
+     *
+     * \param[in]   index
+     *              The index of the request, for the callback
+     * \param[in]   body_callback
+     *              Called with the body, or NULL to discard it
+     * \param[in]   ctx
+     *              The context of the callback
+     * \param[out]  response
+     *              The response
+     *
+     * \return  0 if successful, HELLO_HTTPS_CLIENT_ERR_CONNECTION if the
+     *          connection is closed before the end of the response,
+     *          HELLO_HTTPS_CLIENT_ERR_RESPONSE if the response is invalid, or
+     *          the value returned by the callback
+     */
+    int readResponse(size_t index, BodyCallback body_callback, void *ctx,
+                     HttpResponse *response);
+
+    /**
+     * Callback of HttpParser, passing the body to the BodyCallback in ctx
+     */
+    static int deliverBody(void *ctx, const char *data, size_t len);
+
+    /**
+     * Wait until the transport is ready, after an Mbed TLS function returned
+     * MBEDTLS_ERR_SSL_WANT_READ or MBEDTLS_ERR_SSL_WANT_WRITE, without using
+     * the CPU
+     *
+     * \param[in]   want
+     *              MBEDTLS_ERR_SSL_WANT_READ or MBEDTLS_ERR_SSL_WANT_WRITE
+     *
+     * \return  0 when the operation can be tried again,
+     *          MBEDTLS_ERR_SSL_TIMEOUT if nothing happened for
+     *          HELLO_HTTPS_CLIENT_IO_TIMEOUT_MS, another negative value
+     *          otherwise
+     */
+    int waitForTransport(int want);
+
+    /**
+     * Keep the start of the body and look for HTTP_HELLO_STR in it, with the
+     * ResponseCheck in ctx
+     */
+    static int checkBody(void *ctx, size_t index, const char *data,
+                         size_t len);
+
+    /**
+     * Check that the response is '200 OK' and contains HTTP_HELLO_STR, and
+     * print it
+     */
+    static int checkResponse(void *ctx, size_t index,
+                             const HttpResponse *response);
+
+    /**
+     * Count the '200 OK' responses with the body length of the first fetch,
+     * and those among them that were chunked, in the PipelineCount in ctx
+     */
+    static int countResponse(void *ctx, size_t index,
+                             const HttpResponse *response);
+
+    /**
+     * Wrapper function around Transport that gets called by Mbed TLS whenever
      * we call mbedtls_ssl_read()
      *
      * \param[in]   ctx
-     *              The TCPSocket object
+     *              The Transport object
      * \param[in]   buf
      *              Buffer where data received will be stored
      * \param[in]   len
@@ -107,11 +372,11 @@ private:
     static int sslRecv(void *ctx, unsigned char *buf, size_t len);
 
     /**
-     * Wrapper function around TCPSocket that gets called by Mbed TLS whenever
+     * Wrapper function around Transport that gets called by Mbed TLS whenever
      * we call mbedtls_ssl_write()
      *
      * \param[in]   ctx
-     *              The TCPSocket object
+     *              The Transport object
      * \param[in]   buf
      *              Buffer containing the data to be sent
      * \param[in]   len
@@ -157,6 +422,35 @@ private:
                          uint32_t *flags);
 
 private:
+    /**
+     * The body callback of a response being received, for deliverBody()
+     */
+    typedef struct {
+        BodyCallback callback;  /**< The callback, or NULL */
+        void *ctx;              /**< The context of the callback */
+        size_t index;           /**< The index of the request */
+    } BodyContext;
+
+    /**
+     * The state of checkBody() and checkResponse()
+     */
+    typedef struct {
+        char preview[HTTP_BODY_PREVIEW_LENGTH]; /**< Start of the body */
+        size_t preview_len;     /**< Length (in bytes) of preview */
+        size_t matched;         /**< Length of the prefix of HTTP_HELLO_STR
+                                     that ends the body so far */
+        size_t body_len;        /**< Length (in bytes) of the whole body */
+    } ResponseCheck;
+
+    /**
+     * The state of countResponse()
+     */
+    typedef struct {
+        size_t body_len;        /**< Expected length (in bytes) of the body */
+        unsigned int received;  /**< Number of the responses received */
+        unsigned int chunked;   /**< Number of them that were chunked */
+    } PipelineCount;
+
     /**
      * Personalization string for the drbg
      */
@@ -168,9 +462,22 @@ private:
     static const size_t ERROR_LOG_BUFFER_LENGTH;
 
     /**
-     * Chain of trusted CAs in PEM format
+     * A trusted CA in DER format
      */
-    static const char *TLS_PEM_CA;
+    typedef struct {
+        const unsigned char *der;   /**< The certificate */
+        size_t len;                 /**< Length (in bytes) of der */
+    } TrustAnchor;
+
+    /**
+     * Trusted CAs, which must stay in memory as long as cacert
+     */
+    static const TrustAnchor TLS_DER_CAS[];
+
+    /**
+     * Number of trusted CAs in TLS_DER_CAS
+     */
+    static const size_t TLS_DER_CAS_COUNT;
 
     /**
      * Path to the file that will be requested from the server
@@ -188,9 +495,50 @@ private:
     static const char *HTTP_HELLO_STR;
 
     /**
-     * Instance of TCPSocket used to communicate with the server
+     * The transport used to communicate with the server
+     */
+    Transport *transport;
+
+    /**
+     * The CA given to addTrustedCa(), if any
+     */
+    TrustAnchor extra_ca;
+
+    /**
+     * Whether configureTlsContexts() succeeded
+     */
+    bool tls_configured;
+
+    /**
+     * Whether the certificate chain of the server was verified during the
+     * last handshake, which does not happen when the session is resumed
+     */
+    bool chain_verified;
+
+    /**
+     * The TLS sessions to resume in the next connections
+     */
+    SessionCache sessions;
+
+    /**
+     * Whether the TLS connection is established
+     */
+    bool connected;
+
+    /**
+     * Number of bytes received in gp_buf and not consumed yet
+     */
+    size_t buffered;
+
+    /**
+     * Number of connections established so far
+     */
+    unsigned int connections;
+
+    /**
+     * Buffer holding the HTTP request being sent
      */
-    TCPSocket socket;
+    char req_buf[HTTP_REQUEST_BUFFER_LENGTH];
 
     /**
      * The server host name to contact
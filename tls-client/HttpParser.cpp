@@ -0,0 +1,335 @@
+/*
+ *  Incremental parser of the HTTP responses of the HTTPS client
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+#include "HttpParser.h"
+
+#include <ctype.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Check whether a string contains the given lowercase token, ignoring the
+ * case
+ */
+static bool containsToken(const char *str, const char *token)
+{
+    size_t len = strlen(token);
+    size_t i;
+
+    for (; *str != '\0'; str++) {
+        for (i = 0; i < len; i++) {
+            if (tolower(static_cast<unsigned char>(str[i])) != token[i])
+                break;
+        }
+        if (i == len)
+            return true;
+    }
+
+    return false;
+}
+
+HttpParser::HttpParser(BodyCallback in_body_callback, void *in_body_ctx) :
+    body_callback(in_body_callback),
+    body_ctx(in_body_ctx)
+{
+    reset();
+}
+
+void HttpParser::reset()
+{
+    state = STATUS_LINE;
+    line_len = 0;
+    line_truncated = false;
+    status_code = 0;
+    keep_alive = true;
+    has_length = false;
+    chunked = false;
+    remaining = 0;
+    received_len = 0;
+    body_len = 0;
+}
+
+int HttpParser::parse(const char *data, size_t len, size_t *consumed)
+{
+    int ret;
+    size_t used;
+
+    *consumed = 0;
+
+    while (*consumed < len && state != DONE) {
+        used = len - *consumed;
+
+        switch (state) {
+        case BODY:
+        case CHUNK_DATA:
+            if (used > remaining)
+                used = remaining;
+            remaining -= used;
+            ret = deliver(data + *consumed, used);
+            if (remaining == 0)
+                state = (state == BODY) ? DONE : CHUNK_END;
+            break;
+
+        case BODY_UNTIL_CLOSE:
+            ret = deliver(data + *consumed, used);
+            break;
+
+        default:
+            used = addToLine(data + *consumed, used);
+            ret = 0;
+            if (data[*consumed + used - 1] == '\n') {
+                ret = parseLine();
+                line_len = 0;
+                line_truncated = false;
+            }
+            break;
+        }
+
+        *consumed += used;
+        received_len += used;
+
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+int HttpParser::finish()
+{
+    if (state == BODY_UNTIL_CLOSE)
+        state = DONE;
+
+    return (state == DONE) ? 0 : HTTP_PARSER_ERR_INVALID;
+}
+
+bool HttpParser::done() const
+{
+    return state == DONE;
+}
+
+bool HttpParser::keepAlive() const
+{
+    return keep_alive;
+}
+
+int HttpParser::status() const
+{
+    return status_code;
+}
+
+size_t HttpParser::received() const
+{
+    return received_len;
+}
+
+size_t HttpParser::bodyLength() const
+{
+    return body_len;
+}
+
+bool HttpParser::chunkedBody() const
+{
+    return chunked;
+}
+
+size_t HttpParser::addToLine(const char *data, size_t len)
+{
+    const char *eol = static_cast<const char *>(memchr(data, '\n', len));
+    size_t used = (eol != NULL) ? static_cast<size_t>(eol - data) + 1 : len;
+    size_t copy = (eol != NULL) ? used - 1 : used;
+
+    /* Keep the start of the line, without the line feed */
+    if (copy > sizeof(line) - 1 - line_len) {
+        copy = sizeof(line) - 1 - line_len;
+        line_truncated = true;
+    }
+    memcpy(line + line_len, data, copy);
+    line_len += copy;
+
+    if (eol != NULL) {
+        if (line_len > 0 && line[line_len - 1] == '\r' && !line_truncated)
+            line_len--;
+        line[line_len] = '\0';
+    }
+
+    return used;
+}
+
+int HttpParser::parseLine()
+{
+    switch (state) {
+    case STATUS_LINE:
+        /* Ignore the empty lines before the status line */
+        return (line_len == 0) ? 0 : parseStatusLine();
+
+    case HEADER_LINE:
+        if (line_len > 0)
+            return parseHeader();
+        endHeaders();
+        return 0;
+
+    case CHUNK_SIZE:
+        return parseChunkSize();
+
+    case CHUNK_END:
+        if (line_len != 0)
+            return HTTP_PARSER_ERR_INVALID;
+        state = CHUNK_SIZE;
+        return 0;
+
+    case TRAILER_LINE:
+        if (line_len == 0)
+            state = DONE;
+        return 0;
+
+    default:
+        return HTTP_PARSER_ERR_INVALID;
+    }
+}
+
+int HttpParser::parseStatusLine()
+{
+    /* "HTTP/1.x SSS", then the reason phrase */
+    if (line_len < 12 || strncmp(line, "HTTP/1.", 7) != 0 ||
+        !isdigit(static_cast<unsigned char>(line[7])) || line[8] != ' ' ||
+        !isdigit(static_cast<unsigned char>(line[9])) ||
+        !isdigit(static_cast<unsigned char>(line[10])) ||
+        !isdigit(static_cast<unsigned char>(line[11])) ||
+        (line[12] != ' ' && line[12] != '\0'))
+        return HTTP_PARSER_ERR_INVALID;
+
+    status_code = (line[9] - '0') * 100 + (line[10] - '0') * 10 +
+                  (line[11] - '0');
+    /* HTTP/1.0 closes the connection unless asked otherwise */
+    keep_alive = line[7] != '0';
+    state = HEADER_LINE;
+
+    return 0;
+}
+
+int HttpParser::parseHeader()
+{
+    const char *value;
+    size_t length = 0;
+
+    if ((value = headerValue("content-length")) != NULL) {
+        if (!isdigit(static_cast<unsigned char>(*value)))
+            return HTTP_PARSER_ERR_INVALID;
+        for (; isdigit(static_cast<unsigned char>(*value)); value++) {
+            if (length > (SIZE_MAX - 9) / 10)
+                return HTTP_PARSER_ERR_INVALID;
+            length = length * 10 + static_cast<size_t>(*value - '0');
+        }
+        if (*value != '\0' && *value != ' ' && *value != '\t')
+            return HTTP_PARSER_ERR_INVALID;
+        if (has_length && length != remaining)
+            return HTTP_PARSER_ERR_INVALID;
+        has_length = true;
+        remaining = length;
+    } else if ((value = headerValue("transfer-encoding")) != NULL) {
+        chunked = containsToken(value, "chunked");
+    } else if ((value = headerValue("connection")) != NULL) {
+        if (containsToken(value, "close"))
+            keep_alive = false;
+        else if (containsToken(value, "keep-alive"))
+            keep_alive = true;
+    }
+
+    return 0;
+}
+
+void HttpParser::endHeaders()
+{
+    /* An interim response is followed by the final one */
+    if (status_code >= 100 && status_code < 200 && status_code != 101) {
+        status_code = 0;
+        has_length = false;
+        chunked = false;
+        remaining = 0;
+        state = STATUS_LINE;
+        return;
+    }
+
+    if (status_code == 204 || status_code == 304) {
+        state = DONE;
+    } else if (chunked) {
+        /* The chunks take precedence over Content-Length */
+        state = CHUNK_SIZE;
+    } else if (has_length) {
+        state = (remaining == 0) ? DONE : BODY;
+    } else {
+        keep_alive = false;
+        state = BODY_UNTIL_CLOSE;
+    }
+}
+
+int HttpParser::parseChunkSize()
+{
+    const char *p;
+    int digit;
+
+    /* Hexadecimal size, then optional extensions after ';' */
+    remaining = 0;
+    for (p = line; isxdigit(static_cast<unsigned char>(*p)); p++) {
+        if (remaining > (SIZE_MAX >> 4))
+            return HTTP_PARSER_ERR_INVALID;
+        digit = isdigit(static_cast<unsigned char>(*p)) ? *p - '0' :
+                tolower(static_cast<unsigned char>(*p)) - 'a' + 10;
+        remaining = (remaining << 4) | static_cast<size_t>(digit);
+    }
+    if (p == line || (*p != '\0' && *p != ';' && *p != ' ' && *p != '\t'))
+        return HTTP_PARSER_ERR_INVALID;
+
+    state = (remaining == 0) ? TRAILER_LINE : CHUNK_DATA;
+
+    return 0;
+}
+
+int HttpParser::deliver(const char *data, size_t len)
+{
+    body_len += len;
+
+    if (body_callback == NULL || len == 0)
+        return 0;
+
+    return body_callback(body_ctx, data, len);
+}
+
+const char *HttpParser::headerValue(const char *name) const
+{
+    size_t len = strlen(name);
+    size_t i;
+    const char *value;
+
+    if (line_len <= len || line[len] != ':')
+        return NULL;
+
+    for (i = 0; i < len; i++) {
+        if (tolower(static_cast<unsigned char>(line[i])) != name[i])
+            return NULL;
+    }
+
+    for (value = line + len + 1; *value == ' ' || *value == '\t'; value++)
+        ;
+
+    return value;
+}
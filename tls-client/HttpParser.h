@@ -0,0 +1,267 @@
+/*
+ *  Incremental parser of the HTTP responses of the HTTPS client
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+#ifndef _HTTPPARSER_H_
+#define _HTTPPARSER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Maximum length (in bytes) of the status line, of a header or of a chunk
+ * size line that the parser looks at. The rest of a longer line is skipped,
+ * which is harmless for the headers that the parser does not use.
+ */
+#define HTTP_PARSER_LINE_LENGTH     128
+
+/**
+ * The response is not valid HTTP/1.x
+ */
+#define HTTP_PARSER_ERR_INVALID     -0x10
+
+/**
+ * This class parses an HTTP/1.x response as it is received, in pieces of any
+ * size, with a state machine. It handles the status line, the headers that
+ * delimit the body (Content-Length, Transfer-Encoding: chunked) or end the
+ * connection (Connection), and the interim 1xx responses. The body is passed
+ * to a callback as it arrives, without copying it, so that responses of any
+ * size are parsed in constant memory and linear time.
+ */
+class HttpParser
+{
+public:
+    /**
+     * Callback receiving the body of the response
+     *
+     * \param[in]   ctx
+     *              The context given to the constructor
+     * \param[in]   data
+     *              The next bytes of the body, without the chunk framing
+     * \param[in]   len
+     *              The number of bytes
+     *
+     * \return  0 to continue, another value to stop parse() and return it
+     */
+    typedef int (*BodyCallback)(void *ctx, const char *data, size_t len);
+
+    /**
+     * Construct a parser waiting for a response
+     *
+     * \param[in]   body_callback
+     *              Called with the body, or NULL to discard it
+     * \param[in]   body_ctx
+     *              The context of the callback
+     */
+    HttpParser(BodyCallback body_callback, void *body_ctx);
+
+    /**
+     * Wait for a new response
+     */
+    void reset();
+
+    /**
+     * Parse the next bytes of the response. Parsing stops at the end of the
+     * response, so that the bytes of the next one are left to the caller.
+     *
+     * \param[in]   data
+     *              The bytes received
+     * \param[in]   len
+     *              The number of bytes
+     * \param[out]  consumed
+     *              The number of bytes that belong to the response
+     *
+     * \return  0 if successful, HTTP_PARSER_ERR_INVALID if the response is
+     *          invalid, or the value returned by the body callback
+     */
+    int parse(const char *data, size_t len, size_t *consumed);
+
+    /**
+     * Tell the parser that the connection was closed, which ends a body
+     * that has neither a length nor chunks
+     *
+     * \return  0 if the response is complete, HTTP_PARSER_ERR_INVALID if it
+     *          is truncated
+     */
+    int finish();
+
+    /**
+     * Check whether the whole response was parsed
+     */
+    bool done() const;
+
+    /**
+     * Check whether the connection can carry the next response. This is only
+     * meaningful once the headers are parsed.
+     */
+    bool keepAlive() const;
+
+    /**
+     * Get the status code, such as 200, or 0 before the status line is parsed
+     */
+    int status() const;
+
+    /**
+     * Get the number of bytes of the response parsed so far
+     */
+    size_t received() const;
+
+    /**
+     * Get the number of bytes of the body passed to the callback so far
+     */
+    size_t bodyLength() const;
+
+    /**
+     * Check whether the body is chunked. This is only meaningful once the
+     * headers are parsed.
+     */
+    bool chunkedBody() const;
+
+private:
+    /**
+     * Parser states, in the order of the response
+     */
+    typedef enum {
+        STATUS_LINE,        /**< Waiting for the status line */
+        HEADER_LINE,        /**< Waiting for a header or the empty line */
+        BODY,               /**< In a body of known length */
+        BODY_UNTIL_CLOSE,   /**< In a body that ends with the connection */
+        CHUNK_SIZE,         /**< Waiting for the size line of a chunk */
+        CHUNK_DATA,         /**< In the data of a chunk */
+        CHUNK_END,          /**< Waiting for the line ending a chunk */
+        TRAILER_LINE,       /**< Waiting for a trailer or the empty line */
+        DONE,               /**< The response is complete */
+    } State;
+
+    /**
+     * Add bytes to the current line, up to and including the line feed
+     *
+     * \return  The number of bytes used
+     */
+    size_t addToLine(const char *data, size_t len);
+
+    /**
+     * Handle a complete line, without its line ending
+     *
+     * \return  0 if successful, HTTP_PARSER_ERR_INVALID otherwise
+     */
+    int parseLine();
+
+    /**
+     * Handle the status line
+     */
+    int parseStatusLine();
+
+    /**
+     * Handle a header
+     */
+    int parseHeader();
+
+    /**
+     * Choose how the body is delimited once the headers are parsed
+     */
+    void endHeaders();
+
+    /**
+     * Handle the size line of a chunk
+     */
+    int parseChunkSize();
+
+    /**
+     * Pass body bytes to the callback
+     */
+    int deliver(const char *data, size_t len);
+
+    /**
+     * Check whether the current line is a header with the given lowercase
+     * name
+     *
+     * \return  The value without the leading spaces, or NULL
+     */
+    const char *headerValue(const char *name) const;
+
+    /**
+     * The callback receiving the body
+     */
+    BodyCallback body_callback;
+
+    /**
+     * The context of the callback
+     */
+    void *body_ctx;
+
+    /**
+     * The current state
+     */
+    State state;
+
+    /**
+     * The current line, truncated to HTTP_PARSER_LINE_LENGTH - 1 bytes and
+     * NUL-terminated once complete
+     */
+    char line[HTTP_PARSER_LINE_LENGTH];
+
+    /**
+     * The number of bytes in line
+     */
+    size_t line_len;
+
+    /**
+     * Whether the current line is longer than line
+     */
+    bool line_truncated;
+
+    /**
+     * The status code
+     */
+    int status_code;
+
+    /**
+     * Whether the connection stays open after the response
+     */
+    bool keep_alive;
+
+    /**
+     * Whether the response has a Content-Length header
+     */
+    bool has_length;
+
+    /**
+     * Whether the body is chunked
+     */
+    bool chunked;
+
+    /**
+     * The bytes left in the body or in the current chunk
+     */
+    size_t remaining;
+
+    /**
+     * The bytes of the response parsed so far
+     */
+    size_t received_len;
+
+    /**
+     * The bytes of the body passed to the callback so far
+     */
+    size_t body_len;
+};
+
+#endif /* _HTTPPARSER_H_ */
@@ -0,0 +1,419 @@
+/*
+ *  HTTPS server answering the client in the same program
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+/* Test fixture of the Linux host, not built for the boards */
+#if !defined(__MBED__)
+
+#include "LocalServer.h"
+
+#include "mbedtls/platform.h"
+#include "mbedtls/config.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/pk.h"
+#include "mbedtls/net_sockets.h"
+
+#include <string.h>
+
+const char *const LocalServer::HTTP_RESPONSE[] = {
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/plain\r\n"
+    "Content-Length: 13\r\n"
+    "\r\n"
+    "Hello world!\n",
+};
+
+const size_t LocalServer::HTTP_RESPONSE_PARTS =
+    sizeof(HTTP_RESPONSE) / sizeof(HTTP_RESPONSE[0]);
+
+const char *const LocalServer::HTTP_CHUNKED_RESPONSE[] = {
+    "HTTP/1.1 100 Continue\r\n"
+    "\r\n",
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/plain\r\n"
+    "Transfer-Encoding: chunked\r\n"
+    "Trailer: X-Chunks\r\n"
+    "\r\n",
+    "6;part=1\r\n"
+    "Hello \r\n",
+    "7\r\n"
+    "world!\n\r\n",
+    "0\r\n"
+    "X-Chunks: 2\r\n"
+    "\r\n",
+};
+
+const size_t LocalServer::HTTP_CHUNKED_RESPONSE_PARTS =
+    sizeof(HTTP_CHUNKED_RESPONSE) / sizeof(HTTP_CHUNKED_RESPONSE[0]);
+
+const char *LocalServer::DRBG_PERSONALIZED_STR = "Mbed TLS local server";
+
+/*
+ * Self-signed CA "C=UK, O=Arm Limited, CN=Local Server CA" with a P-256 key,
+ * in DER format
+ */
+const unsigned char LocalServer::CA_DER[] = {
+    0x30, 0x82, 0x01, 0xCE, 0x30, 0x82, 0x01, 0x74, 0xA0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x01, 0x30, 0x0A, 0x06, 0x08, 0x2A, 0x86, 0x48, 0xCE,
+    0x3D, 0x04, 0x03, 0x02, 0x30, 0x3D, 0x31, 0x0B, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x4B, 0x31, 0x14, 0x30, 0x12, 0x06,
+    0x03, 0x55, 0x04, 0x0A, 0x0C, 0x0B, 0x41, 0x72, 0x6D, 0x20, 0x4C, 0x69,
+    0x6D, 0x69, 0x74, 0x65, 0x64, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55,
+    0x04, 0x03, 0x0C, 0x0F, 0x4C, 0x6F, 0x63, 0x61, 0x6C, 0x20, 0x53, 0x65,
+    0x72, 0x76, 0x65, 0x72, 0x20, 0x43, 0x41, 0x30, 0x20, 0x17, 0x0D, 0x32,
+    0x36, 0x31, 0x30, 0x31, 0x37, 0x30, 0x30, 0x33, 0x31, 0x33, 0x33, 0x5A,
+    0x18, 0x0F, 0x32, 0x31, 0x32, 0x36, 0x30, 0x39, 0x32, 0x33, 0x30, 0x30,
+    0x33, 0x31, 0x33, 0x33, 0x5A, 0x30, 0x3D, 0x31, 0x0B, 0x30, 0x09, 0x06,
+    0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x4B, 0x31, 0x14, 0x30, 0x12,
+    0x06, 0x03, 0x55, 0x04, 0x0A, 0x0C, 0x0B, 0x41, 0x72, 0x6D, 0x20, 0x4C,
+    0x69, 0x6D, 0x69, 0x74, 0x65, 0x64, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03,
+    0x55, 0x04, 0x03, 0x0C, 0x0F, 0x4C, 0x6F, 0x63, 0x61, 0x6C, 0x20, 0x53,
+    0x65, 0x72, 0x76, 0x65, 0x72, 0x20, 0x43, 0x41, 0x30, 0x59, 0x30, 0x13,
+    0x06, 0x07, 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x02, 0x01, 0x06, 0x08, 0x2A,
+    0x86, 0x48, 0xCE, 0x3D, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00, 0x04, 0x39,
+    0xEA, 0x1E, 0xA1, 0x97, 0xB6, 0xCF, 0x10, 0x54, 0x26, 0xF4, 0x35, 0x6D,
+    0x00, 0xE9, 0xBA, 0x6A, 0x74, 0xD7, 0xAE, 0x71, 0xD9, 0x82, 0xFA, 0x6D,
+    0x98, 0xE2, 0x6F, 0x04, 0xCB, 0xF5, 0xB5, 0x67, 0xB5, 0x4E, 0xEE, 0x1C,
+    0xB8, 0x5A, 0x3B, 0x47, 0x23, 0x18, 0xF8, 0xC1, 0xEA, 0xC9, 0x80, 0xAC,
+    0xF0, 0xDE, 0x8A, 0x2D, 0x8E, 0xB6, 0x10, 0x50, 0xC3, 0xB5, 0x3F, 0xBA,
+    0x48, 0xF7, 0xC8, 0xA3, 0x63, 0x30, 0x61, 0x30, 0x1D, 0x06, 0x03, 0x55,
+    0x1D, 0x0E, 0x04, 0x16, 0x04, 0x14, 0x25, 0x45, 0x03, 0x14, 0xA0, 0xA8,
+    0x28, 0x8D, 0xEB, 0xD6, 0x20, 0x77, 0x09, 0x13, 0x91, 0x19, 0x39, 0x56,
+    0x02, 0x77, 0x30, 0x1F, 0x06, 0x03, 0x55, 0x1D, 0x23, 0x04, 0x18, 0x30,
+    0x16, 0x80, 0x14, 0x25, 0x45, 0x03, 0x14, 0xA0, 0xA8, 0x28, 0x8D, 0xEB,
+    0xD6, 0x20, 0x77, 0x09, 0x13, 0x91, 0x19, 0x39, 0x56, 0x02, 0x77, 0x30,
+    0x0F, 0x06, 0x03, 0x55, 0x1D, 0x13, 0x01, 0x01, 0xFF, 0x04, 0x05, 0x30,
+    0x03, 0x01, 0x01, 0xFF, 0x30, 0x0E, 0x06, 0x03, 0x55, 0x1D, 0x0F, 0x01,
+    0x01, 0xFF, 0x04, 0x04, 0x03, 0x02, 0x02, 0x04, 0x30, 0x0A, 0x06, 0x08,
+    0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x02, 0x03, 0x48, 0x00, 0x30,
+    0x45, 0x02, 0x21, 0x00, 0xBE, 0x4E, 0xB7, 0x7A, 0x57, 0x7F, 0x92, 0x4D,
+    0x23, 0x09, 0xE0, 0x95, 0xCF, 0xE3, 0x5F, 0x98, 0x60, 0x87, 0xD2, 0xBE,
+    0x04, 0xA9, 0xA4, 0xA1, 0x62, 0xF4, 0x1C, 0xA7, 0x23, 0x54, 0x4F, 0x5A,
+    0x02, 0x20, 0x1E, 0xAF, 0xA2, 0xCE, 0x9E, 0x0B, 0xC5, 0x40, 0x18, 0x24,
+    0x15, 0xFB, 0x14, 0x77, 0x9F, 0x53, 0x70, 0xD7, 0x8A, 0x7A, 0x1D, 0xBD,
+    0x1E, 0xF7, 0x7D, 0xC1, 0xE3, 0xC8, 0x7E, 0x30, 0x6F, 0xA1
+};
+
+const size_t LocalServer::CA_DER_LEN = sizeof(CA_DER);
+
+/*
+ * Certificate of the server for "localhost", signed by CA_DER, in DER format
+ */
+static const unsigned char LOCAL_SERVER_CRT_DER[] = {
+    0x30, 0x82, 0x01, 0xC9, 0x30, 0x82, 0x01, 0x6E, 0xA0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x01, 0x02, 0x30, 0x0A, 0x06, 0x08, 0x2A, 0x86, 0x48, 0xCE,
+    0x3D, 0x04, 0x03, 0x02, 0x30, 0x3D, 0x31, 0x0B, 0x30, 0x09, 0x06, 0x03,
+    0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x4B, 0x31, 0x14, 0x30, 0x12, 0x06,
+    0x03, 0x55, 0x04, 0x0A, 0x0C, 0x0B, 0x41, 0x72, 0x6D, 0x20, 0x4C, 0x69,
+    0x6D, 0x69, 0x74, 0x65, 0x64, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55,
+    0x04, 0x03, 0x0C, 0x0F, 0x4C, 0x6F, 0x63, 0x61, 0x6C, 0x20, 0x53, 0x65,
+    0x72, 0x76, 0x65, 0x72, 0x20, 0x43, 0x41, 0x30, 0x20, 0x17, 0x0D, 0x32,
+    0x36, 0x31, 0x30, 0x31, 0x37, 0x30, 0x30, 0x33, 0x31, 0x33, 0x33, 0x5A,
+    0x18, 0x0F, 0x32, 0x31, 0x32, 0x36, 0x30, 0x39, 0x32, 0x33, 0x30, 0x30,
+    0x33, 0x31, 0x33, 0x33, 0x5A, 0x30, 0x37, 0x31, 0x0B, 0x30, 0x09, 0x06,
+    0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x4B, 0x31, 0x14, 0x30, 0x12,
+    0x06, 0x03, 0x55, 0x04, 0x0A, 0x0C, 0x0B, 0x41, 0x72, 0x6D, 0x20, 0x4C,
+    0x69, 0x6D, 0x69, 0x74, 0x65, 0x64, 0x31, 0x12, 0x30, 0x10, 0x06, 0x03,
+    0x55, 0x04, 0x03, 0x0C, 0x09, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 0x68, 0x6F,
+    0x73, 0x74, 0x30, 0x59, 0x30, 0x13, 0x06, 0x07, 0x2A, 0x86, 0x48, 0xCE,
+    0x3D, 0x02, 0x01, 0x06, 0x08, 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x03, 0x01,
+    0x07, 0x03, 0x42, 0x00, 0x04, 0x7F, 0x7A, 0xAB, 0xAA, 0x5A, 0x9B, 0x4C,
+    0xF0, 0xB0, 0x69, 0x68, 0xF2, 0xC8, 0x29, 0xE5, 0x13, 0x37, 0x8B, 0xAC,
+    0xE3, 0x64, 0xE4, 0x86, 0xBF, 0xB5, 0xD4, 0xFB, 0x81, 0x0F, 0xF2, 0xA7,
+    0xAB, 0x15, 0xA8, 0x15, 0x70, 0xE7, 0x38, 0x33, 0x96, 0x07, 0x08, 0x9C,
+    0x72, 0x5C, 0x7F, 0x88, 0x84, 0x4A, 0x06, 0x85, 0x35, 0x1F, 0x9B, 0x79,
+    0x4F, 0x77, 0x52, 0x1A, 0x44, 0x37, 0x36, 0x2D, 0x71, 0xA3, 0x63, 0x30,
+    0x61, 0x30, 0x09, 0x06, 0x03, 0x55, 0x1D, 0x13, 0x04, 0x02, 0x30, 0x00,
+    0x30, 0x14, 0x06, 0x03, 0x55, 0x1D, 0x11, 0x04, 0x0D, 0x30, 0x0B, 0x82,
+    0x09, 0x6C, 0x6F, 0x63, 0x61, 0x6C, 0x68, 0x6F, 0x73, 0x74, 0x30, 0x1D,
+    0x06, 0x03, 0x55, 0x1D, 0x0E, 0x04, 0x16, 0x04, 0x14, 0xB2, 0x6C, 0x59,
+    0x53, 0xC6, 0x87, 0x9C, 0x59, 0xF0, 0x3B, 0x92, 0x71, 0x0D, 0xCA, 0xEE,
+    0x88, 0x95, 0x15, 0x77, 0x28, 0x30, 0x1F, 0x06, 0x03, 0x55, 0x1D, 0x23,
+    0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0x25, 0x45, 0x03, 0x14, 0xA0, 0xA8,
+    0x28, 0x8D, 0xEB, 0xD6, 0x20, 0x77, 0x09, 0x13, 0x91, 0x19, 0x39, 0x56,
+    0x02, 0x77, 0x30, 0x0A, 0x06, 0x08, 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04,
+    0x03, 0x02, 0x03, 0x49, 0x00, 0x30, 0x46, 0x02, 0x21, 0x00, 0xFC, 0xA5,
+    0xBB, 0xCE, 0x64, 0xBA, 0xC5, 0x3E, 0x9B, 0x06, 0x19, 0x14, 0xBB, 0xF6,
+    0xF6, 0xF9, 0xA7, 0x11, 0x2C, 0x03, 0xDB, 0x5A, 0x92, 0xB3, 0x74, 0x53,
+    0x39, 0xC7, 0xD1, 0xFC, 0xC7, 0x7B, 0x02, 0x21, 0x00, 0xC0, 0xF6, 0x36,
+    0x56, 0xE6, 0x2D, 0xEA, 0x54, 0x1C, 0xF5, 0x07, 0x57, 0x8E, 0x80, 0x9A,
+    0x7E, 0x36, 0xBD, 0x63, 0xF8, 0x2D, 0x37, 0x0E, 0x41, 0xE3, 0xBE, 0xEE,
+    0xBE, 0xCD, 0xA1, 0x67, 0xEC
+};
+
+/*
+ * Private P-256 key of the server, in DER format. It is public, so it must
+ * never be used for anything else than this local test server.
+ */
+static const unsigned char LOCAL_SERVER_KEY_DER[] = {
+    0x30, 0x77, 0x02, 0x01, 0x01, 0x04, 0x20, 0x3D, 0x2D, 0xAF, 0xC6, 0x61,
+    0x9A, 0x6A, 0x72, 0x3A, 0xF1, 0xC7, 0x7C, 0xD8, 0x57, 0xE4, 0x37, 0x90,
+    0xCD, 0xB2, 0x3A, 0x84, 0xA8, 0xB7, 0xE3, 0x13, 0xA9, 0x3E, 0x72, 0xF3,
+    0xC8, 0xA0, 0xC7, 0xA0, 0x0A, 0x06, 0x08, 0x2A, 0x86, 0x48, 0xCE, 0x3D,
+    0x03, 0x01, 0x07, 0xA1, 0x44, 0x03, 0x42, 0x00, 0x04, 0x7F, 0x7A, 0xAB,
+    0xAA, 0x5A, 0x9B, 0x4C, 0xF0, 0xB0, 0x69, 0x68, 0xF2, 0xC8, 0x29, 0xE5,
+    0x13, 0x37, 0x8B, 0xAC, 0xE3, 0x64, 0xE4, 0x86, 0xBF, 0xB5, 0xD4, 0xFB,
+    0x81, 0x0F, 0xF2, 0xA7, 0xAB, 0x15, 0xA8, 0x15, 0x70, 0xE7, 0x38, 0x33,
+    0x96, 0x07, 0x08, 0x9C, 0x72, 0x5C, 0x7F, 0x88, 0x84, 0x4A, 0x06, 0x85,
+    0x35, 0x1F, 0x9B, 0x79, 0x4F, 0x77, 0x52, 0x1A, 0x44, 0x37, 0x36, 0x2D,
+    0x71
+};
+
+LocalServer::LocalServer() :
+    client_end(&to_client, &to_server, this),
+    server_end(&to_server, &to_client, NULL),
+    state(CLOSED),
+    request_len(0),
+    response(NULL),
+    response_parts(0),
+    part(0),
+    part_offset(0),
+    responses(0)
+{
+    mbedtls_entropy_init(&entropy);
+    mbedtls_ctr_drbg_init(&ctr_drbg);
+    mbedtls_x509_crt_init(&srvcert);
+    mbedtls_pk_init(&pkey);
+#if defined(MBEDTLS_SSL_CACHE_C)
+    mbedtls_ssl_cache_init(&cache);
+#endif /* MBEDTLS_SSL_CACHE_C */
+    mbedtls_ssl_init(&ssl);
+    mbedtls_ssl_config_init(&ssl_conf);
+}
+
+LocalServer::~LocalServer()
+{
+    mbedtls_entropy_free(&entropy);
+    mbedtls_ctr_drbg_free(&ctr_drbg);
+    mbedtls_x509_crt_free(&srvcert);
+    mbedtls_pk_free(&pkey);
+#if defined(MBEDTLS_SSL_CACHE_C)
+    mbedtls_ssl_cache_free(&cache);
+#endif /* MBEDTLS_SSL_CACHE_C */
+    mbedtls_ssl_free(&ssl);
+    mbedtls_ssl_config_free(&ssl_conf);
+}
+
+int LocalServer::setup()
+{
+    int ret;
+
+    ret = mbedtls_ctr_drbg_seed(&ctr_drbg, mbedtls_entropy_func, &entropy,
+            reinterpret_cast<const unsigned char *>(DRBG_PERSONALIZED_STR),
+            strlen(DRBG_PERSONALIZED_STR) + 1);
+    if (ret != 0) {
+        mbedtls_printf("mbedtls_ctr_drbg_seed() returned -0x%04X\n", -ret);
+        return ret;
+    }
+
+    ret = mbedtls_x509_crt_parse_der(&srvcert, LOCAL_SERVER_CRT_DER,
+                                     sizeof(LOCAL_SERVER_CRT_DER));
+    if (ret != 0) {
+        mbedtls_printf("mbedtls_x509_crt_parse_der() returned -0x%04X\n",
+                       -ret);
+        return ret;
+    }
+
+    ret = mbedtls_pk_parse_key(&pkey, LOCAL_SERVER_KEY_DER,
+                               sizeof(LOCAL_SERVER_KEY_DER), NULL, 0);
+    if (ret != 0) {
+        mbedtls_printf("mbedtls_pk_parse_key() returned -0x%04X\n", -ret);
+        return ret;
+    }
+
+    ret = mbedtls_ssl_config_defaults(&ssl_conf, MBEDTLS_SSL_IS_SERVER,
+                                      MBEDTLS_SSL_TRANSPORT_STREAM,
+                                      MBEDTLS_SSL_PRESET_DEFAULT);
+    if (ret != 0) {
+        mbedtls_printf("mbedtls_ssl_config_defaults() returned -0x%04X\n",
+                       -ret);
+        return ret;
+    }
+
+    mbedtls_ssl_conf_rng(&ssl_conf, mbedtls_ctr_drbg_random, &ctr_drbg);
+
+    if ((ret = mbedtls_ssl_conf_own_cert(&ssl_conf, &srvcert, &pkey)) != 0) {
+        mbedtls_printf("mbedtls_ssl_conf_own_cert() returned -0x%04X\n",
+                       -ret);
+        return ret;
+    }
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+    /* Let the client resume its session, as with a remote server */
+    mbedtls_ssl_conf_session_cache(&ssl_conf, &cache, mbedtls_ssl_cache_get,
+                                   mbedtls_ssl_cache_set);
+#endif /* MBEDTLS_SSL_CACHE_C */
+
+    if ((ret = mbedtls_ssl_setup(&ssl, &ssl_conf)) != 0) {
+        mbedtls_printf("mbedtls_ssl_setup() returned -0x%04X\n", -ret);
+        return ret;
+    }
+
+    mbedtls_ssl_set_bio(&ssl, static_cast<void *>(&server_end), sslSend,
+                        sslRecv, NULL);
+
+    return 0;
+}
+
+Transport *LocalServer::transport()
+{
+    return &client_end;
+}
+
+int LocalServer::accept()
+{
+    int ret;
+
+    if ((ret = mbedtls_ssl_session_reset(&ssl)) != 0) {
+        mbedtls_printf("mbedtls_ssl_session_reset() returned -0x%04X\n",
+                       -ret);
+        return ret;
+    }
+
+    request_len = 0;
+    request[0] = '\0';
+    responses = 0;
+    state = HANDSHAKE;
+
+    return 0;
+}
+
+void LocalServer::poll()
+{
+    int ret = 0;
+
+    /* Go on until the server has to wait for the client */
+    while (state != CLOSED) {
+        switch (state) {
+        case HANDSHAKE:
+            ret = mbedtls_ssl_handshake(&ssl);
+            if (ret == 0)
+                state = READ_REQUEST;
+            break;
+
+        case READ_REQUEST:
+            ret = readRequest();
+            break;
+
+        case WRITE_RESPONSE:
+            ret = writeResponse();
+            break;
+
+        default:
+            break;
+        }
+
+        if (ret == MBEDTLS_ERR_SSL_WANT_READ ||
+            ret == MBEDTLS_ERR_SSL_WANT_WRITE)
+            return;
+
+        if (ret < 0 && ret != MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS) {
+            /* The client closing the connection is not an error */
+            if (ret != MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY &&
+                ret != MBEDTLS_ERR_SSL_CONN_EOF &&
+                ret != MBEDTLS_ERR_NET_CONN_RESET)
+                mbedtls_printf("LocalServer: connection failed with "
+                               "-0x%04X\n", -ret);
+            server_end.close();
+            state = CLOSED;
+        }
+    }
+}
+
+int LocalServer::readRequest()
+{
+    int ret;
+    char *end;
+
+    /* Pipelined requests may already be in the buffer */
+    while ((end = strstr(request, "\r\n\r\n")) == NULL) {
+        if (request_len == sizeof(request) - 1) {
+            mbedtls_printf("LocalServer: the request is too long\n");
+            return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+        }
+
+        ret = mbedtls_ssl_read(&ssl,
+                    reinterpret_cast<unsigned char *>(request + request_len),
+                    sizeof(request) - 1 - request_len);
+        if (ret == 0)
+            return MBEDTLS_ERR_SSL_CONN_EOF;
+        if (ret < 0)
+            return ret;
+
+        request_len += static_cast<size_t>(ret);
+        request[request_len] = '\0';
+    }
+
+    /* Every path has the same response, so drop the request */
+    end += 4;
+    request_len -= static_cast<size_t>(end - request);
+    memmove(request, end, request_len + 1);
+
+    if (responses++ % 2 == 0) {
+        response = HTTP_RESPONSE;
+        response_parts = HTTP_RESPONSE_PARTS;
+    } else {
+        response = HTTP_CHUNKED_RESPONSE;
+        response_parts = HTTP_CHUNKED_RESPONSE_PARTS;
+    }
+    part = 0;
+    part_offset = 0;
+    state = WRITE_RESPONSE;
+
+    return 0;
+}
+
+int LocalServer::writeResponse()
+{
+    int ret;
+    size_t len = strlen(response[part]);
+
+    ret = mbedtls_ssl_write(&ssl,
+            reinterpret_cast<const unsigned char *>(response[part] +
+                                                    part_offset),
+            len - part_offset);
+    if (ret < 0)
+        return ret;
+
+    part_offset += static_cast<size_t>(ret);
+    if (part_offset == len) {
+        part++;
+        part_offset = 0;
+    }
+    if (part == response_parts)
+        state = READ_REQUEST;
+
+    return 0;
+}
+
+int LocalServer::sslRecv(void *ctx, unsigned char *buf, size_t len)
+{
+    return static_cast<MemoryTransport *>(ctx)->recv(buf, len);
+}
+
+int LocalServer::sslSend(void *ctx, const unsigned char *buf, size_t len)
+{
+    return static_cast<MemoryTransport *>(ctx)->send(buf, len);
+}
+
+#endif /* !__MBED__ */
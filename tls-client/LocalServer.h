@@ -0,0 +1,275 @@
+/*
+ *  HTTPS server answering the client in the same program
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+#ifndef _LOCALSERVER_H_
+#define _LOCALSERVER_H_
+
+#include "MemoryTransport.h"
+
+#include "mbedtls/config.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/pk.h"
+#if defined(MBEDTLS_SSL_CACHE_C)
+#include "mbedtls/ssl_cache.h"
+#endif /* MBEDTLS_SSL_CACHE_C */
+
+#include <stddef.h>
+
+/**
+ * Length (in bytes) of the buffer holding the requests received
+ */
+#define LOCAL_SERVER_REQUEST_BUFFER_LENGTH  512
+
+/**
+ * This class implements an HTTPS server that answers every GET request with
+ * "Hello world!", reachable through a MemoryTransport. Every second response
+ * of a connection follows a 100 Continue interim response and is chunked,
+ * with a chunk extension and a trailer, over several records. It lets the
+ * client be run and benchmarked without a network: the handshake and the
+ * records are the same as with a remote server, but nothing depends on the
+ * timing of the network or of another program.
+ *
+ * The server runs in the thread of the client, when the client waits for it
+ * in MemoryTransport::wait(). Its certificate is signed by CA_DER, which the
+ * client must trust.
+ */
+class LocalServer : public MemoryTransport::Peer
+{
+public:
+    /**
+     * Construct a server; setup() must be called before connecting to it
+     */
+    LocalServer();
+
+    /**
+     * Free any allocated resources
+     */
+    ~LocalServer();
+
+    /**
+     * Configure the Mbed TLS structures of the server
+     *
+     * \return  0 if successful, a negative value otherwise
+     */
+    int setup();
+
+    /**
+     * Get the transport that connects the client to the server
+     */
+    Transport *transport();
+
+    /**
+     * The CA that signs the certificate of the server, in DER format
+     */
+    static const unsigned char CA_DER[];
+
+    /**
+     * Length (in bytes) of CA_DER
+     */
+    static const size_t CA_DER_LEN;
+
+    /* Implementation of MemoryTransport::Peer */
+    int accept();
+    void poll();
+
+private:
+    /**
+     * Server states, in the order of a connection
+     */
+    typedef enum {
+        HANDSHAKE,          /**< Running the TLS handshake */
+        READ_REQUEST,       /**< Waiting for the end of a request */
+        WRITE_RESPONSE,     /**< Sending the response */
+        CLOSED,             /**< The connection is closed */
+    } State;
+
+    /**
+     * Receive data until the buffer holds a whole request
+     *
+     * \return  0 if successful, an Mbed TLS error code otherwise
+     */
+    int readRequest();
+
+    /**
+     * Send the next bytes of the response, each part in its own record
+     *
+     * \return  0 if successful, an Mbed TLS error code otherwise
+     */
+    int writeResponse();
+
+    /**
+     * Receive callback of Mbed TLS, reading from server_end
+     *
+     * \param[in]   ctx
+     *              The MemoryTransport of the server
+     * \param[in]   buf
+     *              Buffer where data received will be stored
+     * \param[in]   len
+     *              The length (in bytes) of the buffer
+     *
+     * \return  The number of bytes received, 0 if the client closed the
+     *          connection, or MBEDTLS_ERR_SSL_WANT_READ
+     */
+    static int sslRecv(void *ctx, unsigned char *buf, size_t len);
+
+    /**
+     * Send callback of Mbed TLS, writing to server_end
+     *
+     * \param[in]   ctx
+     *              The MemoryTransport of the server
+     * \param[in]   buf
+     *              Buffer containing the data to be sent
+     * \param[in]   len
+     *              The number of bytes to send
+     *
+     * \return  The number of bytes sent, MBEDTLS_ERR_SSL_WANT_WRITE, or
+     *          another negative value if the client closed the connection
+     */
+    static int sslSend(void *ctx, const unsigned char *buf, size_t len);
+
+    /**
+     * The HTTP response sent for the first request and every second one
+     */
+    static const char *const HTTP_RESPONSE[];
+
+    /**
+     * Number of parts in HTTP_RESPONSE
+     */
+    static const size_t HTTP_RESPONSE_PARTS;
+
+    /**
+     * The HTTP response sent for the other requests: an interim response,
+     * then the same body in chunks
+     */
+    static const char *const HTTP_CHUNKED_RESPONSE[];
+
+    /**
+     * Number of parts in HTTP_CHUNKED_RESPONSE
+     */
+    static const size_t HTTP_CHUNKED_RESPONSE_PARTS;
+
+    /**
+     * Personalization string for the drbg
+     */
+    static const char *DRBG_PERSONALIZED_STR;
+
+    /**
+     * The bytes sent from the client to the server
+     */
+    MemoryTransport::Pipe to_server;
+
+    /**
+     * The bytes sent from the server to the client
+     */
+    MemoryTransport::Pipe to_client;
+
+    /**
+     * The end of the connection used by the client
+     */
+    MemoryTransport client_end;
+
+    /**
+     * The end of the connection used by the server
+     */
+    MemoryTransport server_end;
+
+    /**
+     * The current state
+     */
+    State state;
+
+    /**
+     * The requests received and not answered yet, NUL-terminated
+     */
+    char request[LOCAL_SERVER_REQUEST_BUFFER_LENGTH];
+
+    /**
+     * Length (in bytes) of the data in request
+     */
+    size_t request_len;
+
+    /**
+     * The parts of the response being sent
+     */
+    const char *const *response;
+
+    /**
+     * Number of parts in response
+     */
+    size_t response_parts;
+
+    /**
+     * Index of the part of the response being sent
+     */
+    size_t part;
+
+    /**
+     * Number of bytes of the current part sent so far
+     */
+    size_t part_offset;
+
+    /**
+     * Number of responses started on the connection
+     */
+    unsigned int responses;
+
+    /**
+     * Entropy context used to seed the DRBG
+     */
+    mbedtls_entropy_context entropy;
+
+    /**
+     * The DRBG used by the TLS connection
+     */
+    mbedtls_ctr_drbg_context ctr_drbg;
+
+    /**
+     * The certificate of the server
+     */
+    mbedtls_x509_crt srvcert;
+
+    /**
+     * The private key of the server
+     */
+    mbedtls_pk_context pkey;
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+    /**
+     * The sessions that the client can resume
+     */
+    mbedtls_ssl_cache_context cache;
+#endif /* MBEDTLS_SSL_CACHE_C */
+
+    /**
+     * The TLS context
+     */
+    mbedtls_ssl_context ssl;
+
+    /**
+     * The TLS configuration in use
+     */
+    mbedtls_ssl_config ssl_conf;
+};
+
+#endif /* _LOCALSERVER_H_ */
@@ -0,0 +1,121 @@
+/*
+ *  In-memory transport of the HTTPS client
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+/* Test fixture of the Linux host, not built for the boards */
+#if !defined(__MBED__)
+
+#include "MemoryTransport.h"
+
+#include "mbedtls/config.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/net_sockets.h"
+
+#include <string.h>
+
+MemoryTransport::MemoryTransport(Pipe *in_rx, Pipe *in_tx, Peer *in_peer) :
+    rx(in_rx),
+    tx(in_tx),
+    peer(in_peer)
+{
+}
+
+int MemoryTransport::connect(const char *host, uint16_t port)
+{
+    (void)host;
+    (void)port;
+
+    rx->start = rx->len = 0;
+    rx->closed = false;
+    tx->start = tx->len = 0;
+    tx->closed = false;
+
+    return (peer != NULL) ? peer->accept() : 0;
+}
+
+int MemoryTransport::send(const unsigned char *buf, size_t len)
+{
+    size_t end, copy;
+
+    if (tx->closed)
+        return MBEDTLS_ERR_NET_CONN_RESET;
+    if (tx->len == sizeof(tx->buf))
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+
+    /* Append to the ring buffer, which may wrap around */
+    if (len > sizeof(tx->buf) - tx->len)
+        len = sizeof(tx->buf) - tx->len;
+    end = (tx->start + tx->len) % sizeof(tx->buf);
+    copy = sizeof(tx->buf) - end;
+    if (copy > len)
+        copy = len;
+    memcpy(tx->buf + end, buf, copy);
+    memcpy(tx->buf, buf + copy, len - copy);
+    tx->len += len;
+
+    return static_cast<int>(len);
+}
+
+int MemoryTransport::recv(unsigned char *buf, size_t len)
+{
+    size_t copy;
+
+    if (rx->len == 0)
+        return rx->closed ? 0 : MBEDTLS_ERR_SSL_WANT_READ;
+
+    if (len > rx->len)
+        len = rx->len;
+    copy = sizeof(rx->buf) - rx->start;
+    if (copy > len)
+        copy = len;
+    memcpy(buf, rx->buf + rx->start, copy);
+    memcpy(buf + copy, rx->buf, len - copy);
+    rx->start = (rx->start + len) % sizeof(rx->buf);
+    rx->len -= len;
+
+    return static_cast<int>(len);
+}
+
+int MemoryTransport::wait(int want, int timeout)
+{
+    (void)timeout;
+
+    if (!ready(want) && peer != NULL)
+        peer->poll();
+
+    /* Nothing else can happen, so waiting longer would not help */
+    return ready(want) ? 0 : MBEDTLS_ERR_SSL_TIMEOUT;
+}
+
+void MemoryTransport::close()
+{
+    rx->closed = true;
+    tx->closed = true;
+}
+
+bool MemoryTransport::ready(int want) const
+{
+    if (want == MBEDTLS_ERR_SSL_WANT_WRITE)
+        return tx->closed || tx->len < sizeof(tx->buf);
+
+    return rx->closed || rx->len > 0;
+}
+
+#endif /* !__MBED__ */
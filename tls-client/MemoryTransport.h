@@ -0,0 +1,119 @@
+/*
+ *  In-memory transport of the HTTPS client
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+#ifndef _MEMORYTRANSPORT_H_
+#define _MEMORYTRANSPORT_H_
+
+#include "Transport.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Capacity (in bytes) of each direction of a MemoryTransport. A TLS record
+ * that does not fit is sent in several pieces.
+ */
+#define MEMORY_TRANSPORT_PIPE_LENGTH    4096
+
+/**
+ * This class connects two ends of a TLS connection in the same program
+ * through a pipe in each direction, without a network or a thread. The client
+ * end drives the other one: when the client has to wait, wait() lets the
+ * Peer at the other end process what it received and answer, so the
+ * exchange only depends on the data and not on the timing of a network.
+ */
+class MemoryTransport : public Transport
+{
+public:
+    /**
+     * The program at the other end of the connection, such as LocalServer
+     */
+    class Peer
+    {
+    public:
+        virtual ~Peer() {}
+
+        /**
+         * Start a new connection, after the pipes were emptied
+         *
+         * \return  0 if successful, a negative value otherwise
+         */
+        virtual int accept() = 0;
+
+        /**
+         * Process the data received and send the answers, until there is
+         * nothing left to do before the next data
+         */
+        virtual void poll() = 0;
+    };
+
+    /**
+     * The bytes in flight in one direction
+     */
+    typedef struct {
+        unsigned char buf[MEMORY_TRANSPORT_PIPE_LENGTH];
+        size_t start;           /**< Offset of the first byte in buf */
+        size_t len;             /**< Number of bytes in buf */
+        bool closed;            /**< The connection was closed */
+    } Pipe;
+
+    /**
+     * Construct one end of a connection
+     *
+     * \param[in]   in_rx
+     *              The pipe that this end reads from
+     * \param[in]   in_tx
+     *              The pipe that this end writes to
+     * \param[in]   in_peer
+     *              The peer that wait() runs, or NULL at the peer end
+     */
+    MemoryTransport(Pipe *in_rx, Pipe *in_tx, Peer *in_peer);
+
+    /* Implementation of Transport */
+    int connect(const char *host, uint16_t port);
+    int send(const unsigned char *buf, size_t len);
+    int recv(unsigned char *buf, size_t len);
+    int wait(int want, int timeout);
+    void close();
+
+private:
+    /**
+     * Check whether send() or recv() can proceed
+     */
+    bool ready(int want) const;
+
+    /**
+     * The pipe that this end reads from
+     */
+    Pipe *rx;
+
+    /**
+     * The pipe that this end writes to
+     */
+    Pipe *tx;
+
+    /**
+     * The peer at the other end, or NULL
+     */
+    Peer *peer;
+};
+
+#endif /* _MEMORYTRANSPORT_H_ */
@@ -0,0 +1,86 @@
+/*
+ *  Recording of the network activity of the HTTPS client
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+/* Test fixture of the Linux host, not built for the boards */
+#if !defined(__MBED__)
+
+#include "RecordTransport.h"
+
+#include "mbedtls/config.h"
+#include "mbedtls/ssl.h"
+
+#include "mbed.h"
+
+RecordTransport::RecordTransport(Transport *in_inner, FILE *in_trace) :
+    inner(in_inner),
+    trace(in_trace)
+{
+}
+
+int RecordTransport::connect(const char *host, uint16_t port)
+{
+    int ret = inner->connect(host, port);
+
+    if (ret == 0)
+        fprintf(trace, "connect %u\n", port);
+
+    return ret;
+}
+
+int RecordTransport::send(const unsigned char *buf, size_t len)
+{
+    return inner->send(buf, len);
+}
+
+int RecordTransport::recv(unsigned char *buf, size_t len)
+{
+    int ret = inner->recv(buf, len);
+
+    if (ret > 0)
+        fprintf(trace, "recv %d\n", ret);
+
+    return ret;
+}
+
+int RecordTransport::wait(int want, int timeout)
+{
+    int ret;
+    Timer timer;
+
+    if (want != MBEDTLS_ERR_SSL_WANT_READ)
+        return inner->wait(want, timeout);
+
+    timer.start();
+    ret = inner->wait(want, timeout);
+    timer.stop();
+
+    if (ret == 0)
+        fprintf(trace, "wait %d\n", timer.read_ms());
+
+    return ret;
+}
+
+void RecordTransport::close()
+{
+    inner->close();
+}
+
+#endif /* !__MBED__ */
@@ -0,0 +1,70 @@
+/*
+ *  Recording of the network activity of the HTTPS client
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+#ifndef _RECORDTRANSPORT_H_
+#define _RECORDTRANSPORT_H_
+
+#include "Transport.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * This class passes the calls to another transport and writes to a trace
+ * file how the data arrived from the server, so that ReplayTransport can
+ * reproduce it later without the network. The trace has one event per line:
+ * - "connect <port>" when a connection is established
+ * - "recv <bytes>" when recv() returns data
+ * - "wait <ms>" when wait() waited for data to arrive
+ */
+class RecordTransport : public Transport
+{
+public:
+    /**
+     * Construct a transport recording another one
+     *
+     * \param[in]   in_inner
+     *              The transport carrying the data
+     * \param[in]   in_trace
+     *              The trace file, open for writing
+     */
+    RecordTransport(Transport *in_inner, FILE *in_trace);
+
+    /* Implementation of Transport */
+    int connect(const char *host, uint16_t port);
+    int send(const unsigned char *buf, size_t len);
+    int recv(unsigned char *buf, size_t len);
+    int wait(int want, int timeout);
+    void close();
+
+private:
+    /**
+     * The transport carrying the data
+     */
+    Transport *inner;
+
+    /**
+     * The trace file
+     */
+    FILE *trace;
+};
+
+#endif /* _RECORDTRANSPORT_H_ */
@@ -0,0 +1,120 @@
+/*
+ *  Replay of the network activity of the HTTPS client
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+/* Test fixture of the Linux host, not built for the boards */
+#if !defined(__MBED__)
+
+#include "ReplayTransport.h"
+
+#include "mbedtls/platform.h"
+#include "mbedtls/config.h"
+#include "mbedtls/ssl.h"
+
+#include <string.h>
+#include "mbed.h"
+
+ReplayTransport::ReplayTransport(Transport *in_inner, FILE *in_trace,
+                                 bool in_delays) :
+    inner(in_inner),
+    trace(in_trace),
+    delays(in_delays),
+    event(CONNECT),
+    value(0)
+{
+    nextEvent();
+}
+
+int ReplayTransport::connect(const char *host, uint16_t port)
+{
+    /* Skip what is left of the previous connection */
+    while (event != CONNECT && event != END)
+        nextEvent();
+    if (event == CONNECT)
+        nextEvent();
+
+    return inner->connect(host, port);
+}
+
+int ReplayTransport::send(const unsigned char *buf, size_t len)
+{
+    return inner->send(buf, len);
+}
+
+int ReplayTransport::recv(unsigned char *buf, size_t len)
+{
+    int ret;
+
+    /* The data had not arrived yet */
+    if (event == WAIT)
+        return MBEDTLS_ERR_SSL_WANT_READ;
+
+    if (event == RECV && len > value)
+        len = value;
+
+    ret = inner->recv(buf, len);
+    if (ret > 0 && event == RECV) {
+        value -= static_cast<unsigned long>(ret);
+        if (value == 0)
+            nextEvent();
+    }
+
+    return ret;
+}
+
+int ReplayTransport::wait(int want, int timeout)
+{
+    if (want == MBEDTLS_ERR_SSL_WANT_READ && event == WAIT) {
+        if (delays)
+            ThisThread::sleep_for(static_cast<uint32_t>(value));
+        nextEvent();
+    }
+
+    return inner->wait(want, timeout);
+}
+
+void ReplayTransport::close()
+{
+    inner->close();
+}
+
+void ReplayTransport::nextEvent()
+{
+    char name[8];
+
+    /* Stop at the end of the trace or at the first invalid event */
+    if (event == END)
+        return;
+
+    if (fscanf(trace, "%7s %lu", name, &value) != 2) {
+        event = END;
+    } else if (strcmp(name, "connect") == 0) {
+        event = CONNECT;
+    } else if (strcmp(name, "recv") == 0 && value > 0) {
+        event = RECV;
+    } else if (strcmp(name, "wait") == 0) {
+        event = WAIT;
+    } else {
+        mbedtls_printf("Invalid event '%s' in the trace\n", name);
+        event = END;
+    }
+}
+
+#endif /* !__MBED__ */
@@ -0,0 +1,107 @@
+/*
+ *  Replay of the network activity of the HTTPS client
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+#ifndef _REPLAYTRANSPORT_H_
+#define _REPLAYTRANSPORT_H_
+
+#include "Transport.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * This class replays a trace of RecordTransport over another transport,
+ * usually the MemoryTransport of a LocalServer. The bytes themselves cannot
+ * be replayed, since the random values of the handshake change at every run,
+ * but the way they arrived can: recv() returns data in pieces no larger than
+ * those recorded, and reports that no data has arrived yet where the client
+ * had to wait. The recorded waits are optionally slept for, which adds the
+ * latency of the network and of the remote server to the run.
+ *
+ * Each connection replays the events of the matching connection of the
+ * trace. Once they are used up, the calls go straight to the other transport.
+ */
+class ReplayTransport : public Transport
+{
+public:
+    /**
+     * Construct a transport replaying a trace over another one
+     *
+     * \param[in]   in_inner
+     *              The transport carrying the data
+     * \param[in]   in_trace
+     *              The trace file, open for reading
+     * \param[in]   in_delays
+     *              Whether to sleep for the time of the recorded waits
+     */
+    ReplayTransport(Transport *in_inner, FILE *in_trace, bool in_delays);
+
+    /* Implementation of Transport */
+    int connect(const char *host, uint16_t port);
+    int send(const unsigned char *buf, size_t len);
+    int recv(unsigned char *buf, size_t len);
+    int wait(int want, int timeout);
+    void close();
+
+private:
+    /**
+     * Events of the trace
+     */
+    typedef enum {
+        CONNECT,            /**< A connection was established */
+        RECV,               /**< Data arrived */
+        WAIT,               /**< The client waited for data */
+        END,                /**< The trace is used up or invalid */
+    } Event;
+
+    /**
+     * Read the next event of the trace
+     */
+    void nextEvent();
+
+    /**
+     * The transport carrying the data
+     */
+    Transport *inner;
+
+    /**
+     * The trace file
+     */
+    FILE *trace;
+
+    /**
+     * Whether to sleep for the time of the recorded waits
+     */
+    bool delays;
+
+    /**
+     * The next event of the trace
+     */
+    Event event;
+
+    /**
+     * The bytes left in a RECV event, or the time of a WAIT event in
+     * milliseconds
+     */
+    unsigned long value;
+};
+
+#endif /* _REPLAYTRANSPORT_H_ */
@@ -0,0 +1,175 @@
+/*
+ *  Cache of the TLS sessions of the HTTPS client
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+#include "SessionCache.h"
+
+#include "mbedtls/platform.h"
+#include "mbedtls/ssl.h"
+
+#include <string.h>
+
+SessionCache::SessionCache()
+{
+    size_t i;
+
+    for (i = 0; i < SESSION_CACHE_SIZE; i++) {
+        entries[i].valid = false;
+        mbedtls_ssl_session_init(&entries[i].session);
+    }
+
+    timeout_s = SESSION_CACHE_TIMEOUT;
+    start_ms = Kernel::get_ms_count();
+}
+
+SessionCache::~SessionCache()
+{
+    size_t i;
+
+    for (i = 0; i < SESSION_CACHE_SIZE; i++)
+        clear(&entries[i]);
+}
+
+void SessionCache::setTimeout(uint32_t in_timeout_s)
+{
+    timeout_s = in_timeout_s;
+}
+
+int SessionCache::save(const char *server_name, uint16_t server_port,
+                       const mbedtls_ssl_context *ssl, bool renew)
+{
+    int ret;
+    size_t i;
+    uint64_t saved_s, expiry_s;
+    Entry *entry;
+
+    if (strlen(server_name) >= SESSION_CACHE_NAME_LENGTH)
+        return 0;
+
+    /*
+     * A resumed session keeps the lifetime it got from the full handshake
+     * that negotiated it, or it would never expire while the client keeps
+     * resuming it
+     */
+    entry = find(server_name, server_port);
+    if (renew) {
+        saved_s = now();
+        expiry_s = saved_s + timeout_s;
+    } else if (entry != NULL) {
+        saved_s = entry->saved_s;
+        expiry_s = entry->expiry_s;
+    } else {
+        return 0;
+    }
+
+    /*
+     * Replace the session of the same server, or else take a free entry, or
+     * else evict the oldest session
+     */
+    for (i = 0; entry == NULL && i < SESSION_CACHE_SIZE; i++) {
+        if (!entries[i].valid)
+            entry = &entries[i];
+    }
+    if (entry == NULL) {
+        entry = &entries[0];
+        for (i = 1; i < SESSION_CACHE_SIZE; i++) {
+            if (entries[i].saved_s < entry->saved_s)
+                entry = &entries[i];
+        }
+    }
+    clear(entry);
+
+    if ((ret = mbedtls_ssl_get_session(ssl, &entry->session)) != 0) {
+        mbedtls_printf("mbedtls_ssl_get_session() returned -0x%04X\n", -ret);
+        clear(entry);
+        return ret;
+    }
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+    /* The server may accept its ticket for less time than the cache keeps it */
+    if (entry->session.ticket != NULL && entry->session.ticket_lifetime > 0 &&
+        now() + entry->session.ticket_lifetime < expiry_s)
+        expiry_s = now() + entry->session.ticket_lifetime;
+#endif /* MBEDTLS_SSL_SESSION_TICKETS && MBEDTLS_SSL_CLI_C */
+
+    strcpy(entry->server_name, server_name);
+    entry->server_port = server_port;
+    entry->saved_s = saved_s;
+    entry->expiry_s = expiry_s;
+    entry->valid = true;
+
+    return 0;
+}
+
+int SessionCache::load(const char *server_name, uint16_t server_port,
+                       mbedtls_ssl_context *ssl)
+{
+    int ret;
+    Entry *entry = find(server_name, server_port);
+
+    if (entry == NULL)
+        return 0;
+
+    if (now() >= entry->expiry_s) {
+        clear(entry);
+        return 0;
+    }
+
+    if ((ret = mbedtls_ssl_set_session(ssl, &entry->session)) != 0) {
+        mbedtls_printf("mbedtls_ssl_set_session() returned -0x%04X\n", -ret);
+        return ret;
+    }
+
+    return 1;
+}
+
+void SessionCache::remove(const char *server_name, uint16_t server_port)
+{
+    Entry *entry = find(server_name, server_port);
+
+    if (entry != NULL)
+        clear(entry);
+}
+
+SessionCache::Entry *SessionCache::find(const char *server_name,
+                                        uint16_t server_port)
+{
+    size_t i;
+
+    for (i = 0; i < SESSION_CACHE_SIZE; i++) {
+        if (entries[i].valid && entries[i].server_port == server_port &&
+            strcmp(entries[i].server_name, server_name) == 0)
+            return &entries[i];
+    }
+
+    return NULL;
+}
+
+void SessionCache::clear(Entry *entry)
+{
+    mbedtls_ssl_session_free(&entry->session);
+    mbedtls_ssl_session_init(&entry->session);
+    entry->valid = false;
+}
+
+uint64_t SessionCache::now()
+{
+    return (Kernel::get_ms_count() - start_ms) / 1000;
+}
@@ -0,0 +1,187 @@
+/*
+ *  Cache of the TLS sessions of the HTTPS client
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+#ifndef _SESSIONCACHE_H_
+#define _SESSIONCACHE_H_
+
+#include "mbed.h"
+
+#include "mbedtls/config.h"
+#include "mbedtls/ssl.h"
+
+#include <stdint.h>
+
+/**
+ * Maximum number of sessions kept in the cache
+ */
+#if defined(MBED_CONF_APP_SESSION_CACHE_SIZE)
+#define SESSION_CACHE_SIZE          MBED_CONF_APP_SESSION_CACHE_SIZE
+#else
+#define SESSION_CACHE_SIZE          4
+#endif /* MBED_CONF_APP_SESSION_CACHE_SIZE */
+
+/**
+ * Time (in seconds) after which a cached session expires
+ */
+#if defined(MBED_CONF_APP_SESSION_CACHE_TIMEOUT)
+#define SESSION_CACHE_TIMEOUT       MBED_CONF_APP_SESSION_CACHE_TIMEOUT
+#else
+#define SESSION_CACHE_TIMEOUT       3600
+#endif /* MBED_CONF_APP_SESSION_CACHE_TIMEOUT */
+
+/**
+ * Maximum length (in bytes) of the host name of a cached server, including
+ * the terminating NUL. The sessions of servers with longer names are not
+ * cached.
+ */
+#define SESSION_CACHE_NAME_LENGTH   64
+
+/**
+ * This class keeps the TLS sessions negotiated with servers, so that the next
+ * connection to the same server resumes its session, with the session ID or
+ * the session ticket that the server gave, instead of running a full
+ * handshake with the verification of the certificate chain and the key
+ * exchange.
+ *
+ * The cache holds at most SESSION_CACHE_SIZE sessions, and replaces the
+ * oldest one when it is full. A session expires SESSION_CACHE_TIMEOUT
+ * seconds, or the time given to setTimeout(), after the full handshake that negotiated it, however often it is
+ * resumed in the meantime, or when its ticket expires if that is sooner.
+ */
+class SessionCache
+{
+public:
+    /**
+     * Construct an empty cache
+     */
+    SessionCache();
+
+    /**
+     * Free the cached sessions
+     */
+    ~SessionCache();
+
+    /**
+     * Set the time (in seconds) after which the sessions saved from now on
+     * expire, instead of SESSION_CACHE_TIMEOUT
+     */
+    void setTimeout(uint32_t timeout_s);
+
+    /**
+     * Save the session of a connection after a successful handshake,
+     * replacing the one of the same server if any
+     *
+     * \param[in]   server_name
+     *              The server host name
+     * \param[in]   server_port
+     *              The server port
+     * \param[in]   ssl
+     *              The TLS context of the connection
+     * \param[in]   renew
+     *              true after a full handshake that verified the certificate
+     *              chain of the server, to start a new lifetime for the
+     *              session; false after a resumption, to keep the lifetime of
+     *              the cached session. A resumed session that is no longer in
+     *              the cache is not saved.
+     *
+     * \return  0 if successful, or an Mbed TLS error code
+     */
+    int save(const char *server_name, uint16_t server_port,
+             const mbedtls_ssl_context *ssl, bool renew);
+
+    /**
+     * Set up a connection to resume the session of a server, if the cache
+     * has one that has not expired. This must be called after
+     * mbedtls_ssl_setup() or mbedtls_ssl_session_reset() and before the
+     * handshake.
+     *
+     * \param[in]   server_name
+     *              The server host name
+     * \param[in]   server_port
+     *              The server port
+     * \param[in]   ssl
+     *              The TLS context of the connection
+     *
+     * \return  1 if a session is set up for resumption, 0 if the cache has no
+     *          session for the server, or an Mbed TLS error code
+     */
+    int load(const char *server_name, uint16_t server_port,
+             mbedtls_ssl_context *ssl);
+
+    /**
+     * Forget the session of a server, for instance after a failed handshake
+     *
+     * \param[in]   server_name
+     *              The server host name
+     * \param[in]   server_port
+     *              The server port
+     */
+    void remove(const char *server_name, uint16_t server_port);
+
+private:
+    /**
+     * A cached session and the server it was negotiated with
+     */
+    typedef struct {
+        bool valid;                     /**< The entry holds a session */
+        char server_name[SESSION_CACHE_NAME_LENGTH];
+        uint16_t server_port;
+        uint64_t saved_s;               /**< When the session was negotiated */
+        uint64_t expiry_s;              /**< When the session expires */
+        mbedtls_ssl_session session;
+    } Entry;
+
+    /**
+     * Find the entry of a server
+     *
+     * \return  The entry, or NULL if the cache has none for the server
+     */
+    Entry *find(const char *server_name, uint16_t server_port);
+
+    /**
+     * Free the session of an entry and mark it as unused
+     */
+    void clear(Entry *entry);
+
+    /**
+     * Get the time in seconds since the cache was constructed
+     */
+    uint64_t now();
+
+    /**
+     * The cached sessions
+     */
+    Entry entries[SESSION_CACHE_SIZE];
+
+    /**
+     * Time (in seconds) after which a newly negotiated session expires
+     */
+    uint32_t timeout_s;
+
+    /**
+     * Kernel tick count in milliseconds when the cache was constructed, used
+     * to expire the sessions since the boards do not keep the date. A running
+     * Timer would keep the board out of deep sleep.
+     */
+    uint64_t start_ms;
+};
+
+#endif /* _SESSIONCACHE_H_ */
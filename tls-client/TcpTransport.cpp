@@ -0,0 +1,166 @@
+/*
+ *  TCP transport of the HTTPS client
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+#include "TcpTransport.h"
+
+#include "mbedtls/platform.h"
+#include "mbedtls/config.h"
+#include "mbedtls/ssl.h"
+
+#include "mbed.h"
+
+#if defined(__MBED__)
+const uint32_t TcpTransport::SOCKET_EVENT = 0x1;
+#endif /* __MBED__ */
+
+TcpTransport::TcpTransport(int in_connect_timeout) :
+    network(NULL),
+    socket(),
+    connect_timeout(in_connect_timeout)
+{
+}
+
+TcpTransport::~TcpTransport()
+{
+    socket.close();
+}
+
+int TcpTransport::connect(const char *host, uint16_t port)
+{
+    int ret;
+
+    /* Connect to the network the first time only */
+    if (network == NULL) {
+        network = NetworkInterface::get_default_instance();
+        if(network == NULL) {
+            mbedtls_printf("ERROR: No network interface found!\n");
+            return -1;
+        }
+        ret = network->connect();
+        if (ret != 0) {
+            mbedtls_printf("Error! network->connect() returned: %d\n", ret);
+            network = NULL;
+            return ret;
+        }
+    }
+
+    /* The socket is still open if the previous connection failed */
+    socket.close();
+
+    if ((ret = socket.open(network)) != NSAPI_ERROR_OK) {
+        mbedtls_printf("socket.open() returned %d\n", ret);
+        return ret;
+    }
+
+    socket.set_blocking(false);
+#if defined(__MBED__)
+    /* Wake up wait() when the socket state changes */
+    socket_events.clear(SOCKET_EVENT);
+    socket.sigio(callback(this, &TcpTransport::socketEvent));
+#endif /* __MBED__ */
+
+    /*
+     * The non-blocking socket of Mbed OS may return before the connection is
+     * established, so wait for the network and try again until it reports
+     * that it is connected.
+     */
+    ret = socket.connect(host, port);
+    while (ret == NSAPI_ERROR_IN_PROGRESS || ret == NSAPI_ERROR_ALREADY ||
+           ret == NSAPI_ERROR_WOULD_BLOCK) {
+        if ((ret = wait(MBEDTLS_ERR_SSL_WANT_WRITE, connect_timeout)) != 0)
+            break;
+        ret = socket.connect(host, port);
+    }
+    if (ret == NSAPI_ERROR_IS_CONNECTED)
+        ret = NSAPI_ERROR_OK;
+    if (ret != NSAPI_ERROR_OK) {
+        mbedtls_printf("socket.connect() returned %d\n", ret);
+        return ret;
+    }
+
+    return 0;
+}
+
+int TcpTransport::send(const unsigned char *buf, size_t len)
+{
+    int ret = socket.send(buf, len);
+
+    if (ret == NSAPI_ERROR_WOULD_BLOCK)
+        ret = MBEDTLS_ERR_SSL_WANT_WRITE;
+    else if (ret < 0)
+        mbedtls_printf("socket.send() returned %d\n", ret);
+
+    return ret;
+}
+
+int TcpTransport::recv(unsigned char *buf, size_t len)
+{
+    int ret = socket.recv(buf, len);
+
+    if (ret == NSAPI_ERROR_WOULD_BLOCK)
+        ret = MBEDTLS_ERR_SSL_WANT_READ;
+    else if (ret < 0)
+        mbedtls_printf("socket.recv() returned %d\n", ret);
+
+    return ret;
+}
+
+int TcpTransport::wait(int want, int timeout)
+{
+#if defined(__MBED__)
+    uint32_t flags;
+
+    (void)want;
+
+    /*
+     * sigio() reports any change of the socket state, so the flag may come
+     * from an earlier event and the operation may still not be able to
+     * proceed. The caller then calls this function again.
+     */
+    flags = socket_events.wait_any(SOCKET_EVENT, timeout);
+    if ((flags & osFlagsError) == 0)
+        return 0;
+#else
+    nsapi_error_t err;
+
+    err = socket.wait_ready(want == MBEDTLS_ERR_SSL_WANT_WRITE, timeout);
+    if (err == NSAPI_ERROR_OK)
+        return 0;
+    if (err != NSAPI_ERROR_WOULD_BLOCK) {
+        mbedtls_printf("socket.wait_ready() returned %d\n", err);
+        return err;
+    }
+#endif /* __MBED__ */
+
+    return MBEDTLS_ERR_SSL_TIMEOUT;
+}
+
+void TcpTransport::close()
+{
+    socket.close();
+}
+
+#if defined(__MBED__)
+void TcpTransport::socketEvent()
+{
+    socket_events.set(SOCKET_EVENT);
+}
+#endif /* __MBED__ */
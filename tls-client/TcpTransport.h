@@ -0,0 +1,99 @@
+/*
+ *  TCP transport of the HTTPS client
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+#ifndef _TCPTRANSPORT_H_
+#define _TCPTRANSPORT_H_
+
+#include "Transport.h"
+
+#include "TCPSocket.h"
+#if defined(__MBED__)
+#include "rtos/EventFlags.h"
+#endif /* __MBED__ */
+
+#include <stdint.h>
+
+/**
+ * This class carries the connection over a non-blocking TCPSocket on the
+ * default network interface. wait() sleeps until the socket state changes:
+ * on Mbed OS, the TCPSocket::sigio() callback sets a flag of an EventFlags;
+ * on the host, the socket is polled.
+ */
+class TcpTransport : public Transport
+{
+public:
+    /**
+     * Construct a transport, which connects to the network on the first call
+     * of connect()
+     *
+     * \param[in]   in_connect_timeout
+     *              The maximum time in milliseconds to establish a TCP
+     *              connection
+     */
+    TcpTransport(int in_connect_timeout);
+
+    /**
+     * Close the socket
+     */
+    ~TcpTransport();
+
+    /* Implementation of Transport */
+    int connect(const char *host, uint16_t port);
+    int send(const unsigned char *buf, size_t len);
+    int recv(unsigned char *buf, size_t len);
+    int wait(int want, int timeout);
+    void close();
+
+private:
+#if defined(__MBED__)
+    /**
+     * Callback of TCPSocket::sigio(), called when the socket state changes
+     */
+    void socketEvent();
+
+    /**
+     * Flag set in socket_events by socketEvent()
+     */
+    static const uint32_t SOCKET_EVENT;
+
+    /**
+     * Events of the socket that wait() waits for
+     */
+    rtos::EventFlags socket_events;
+#endif /* __MBED__ */
+
+    /**
+     * The network interface, once connected
+     */
+    NetworkInterface *network;
+
+    /**
+     * Instance of TCPSocket used to communicate with the server
+     */
+    TCPSocket socket;
+
+    /**
+     * The maximum time in milliseconds to establish a TCP connection
+     */
+    int connect_timeout;
+};
+
+#endif /* _TCPTRANSPORT_H_ */
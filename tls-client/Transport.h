@@ -0,0 +1,96 @@
+/*
+ *  Transport of the TLS records of the HTTPS client
+ *
+ *  Copyright (C) 2006-2018, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  This file is part of Mbed TLS (https://tls.mbed.org)
+ */
+
+#ifndef _TRANSPORT_H_
+#define _TRANSPORT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * This interface carries the bytes of a TLS connection between the client
+ * and the server. HelloHttpsClient passes send() and recv() to Mbed TLS, so
+ * they follow the conventions of the callbacks of mbedtls_ssl_set_bio(), and
+ * calls wait() instead of calling Mbed TLS again when it returns
+ * MBEDTLS_ERR_SSL_WANT_READ or MBEDTLS_ERR_SSL_WANT_WRITE.
+ *
+ * The implementations are:
+ * - TcpTransport, a TCPSocket connected to the server
+ * - MemoryTransport, in-memory pipes to a server in the same program, such as
+ *   LocalServer
+ * - RecordTransport and ReplayTransport, which record the reads of another
+ *   transport and replay them on another one
+ */
+class Transport
+{
+public:
+    virtual ~Transport() {}
+
+    /**
+     * Open a connection to the server, closing the previous one if any
+     *
+     * \param[in]   host
+     *              The domain/IP address of the server
+     * \param[in]   port
+     *              The port number of the server
+     *
+     * \return  0 if successful, a negative value otherwise
+     */
+    virtual int connect(const char *host, uint16_t port) = 0;
+
+    /**
+     * Send data without blocking
+     *
+     * \return  The number of bytes sent, MBEDTLS_ERR_SSL_WANT_WRITE if none
+     *          can be sent yet, or another negative value
+     */
+    virtual int send(const unsigned char *buf, size_t len) = 0;
+
+    /**
+     * Receive data without blocking
+     *
+     * \return  The number of bytes received, 0 if the server closed the
+     *          connection, MBEDTLS_ERR_SSL_WANT_READ if none has arrived yet,
+     *          or another negative value
+     */
+    virtual int recv(unsigned char *buf, size_t len) = 0;
+
+    /**
+     * Wait until send() or recv() may proceed, without using the CPU
+     *
+     * \param[in]   want
+     *              MBEDTLS_ERR_SSL_WANT_READ or MBEDTLS_ERR_SSL_WANT_WRITE
+     * \param[in]   timeout
+     *              The maximum time to wait in milliseconds
+     *
+     * \return  0 if the operation can be tried again, MBEDTLS_ERR_SSL_TIMEOUT
+     *          if nothing happened before the timeout, or another negative
+     *          value
+     */
+    virtual int wait(int want, int timeout) = 0;
+
+    /**
+     * Close the connection
+     */
+    virtual void close() = 0;
+};
+
+#endif /* _TRANSPORT_H_ */
@@ -28,8 +28,13 @@
  * for a string in the result.
  *
  * This example is implemented as a logic class (HelloHttpsClient) wrapping a
- * TCP socket. The logic class handles all events, leaving the main loop to just
+ * Transport. The logic class handles all events, leaving the main loop to just
  * check if the process  has finished.
+ *
+ * On the host, the client can instead connect to a server in the same
+ * program (--loopback), and record or replay how the network delivered the
+ * data (--record, --replay), so that it can be run and benchmarked without
+ * depending on the network.
  */
 
 #include "mbed.h"
@@ -40,6 +45,14 @@
 #endif /* MBEDTLS_USE_PSA_CRYPTO */
 
 #include "HelloHttpsClient.h"
+#include "TcpTransport.h"
+#if !defined(__MBED__)
+#include "LocalServer.h"
+#include "RecordTransport.h"
+#include "ReplayTransport.h"
+
+#include <errno.h>
+#endif /* !__MBED__ */
 
 /* Domain/IP address of the server to contact */
 const char SERVER_NAME[] = "os.mbed.com";
@@ -48,17 +61,153 @@ const char SERVER_ADDR[] = "os.mbed.com";
 /* Port used to connect to the server */
 const int SERVER_PORT = 443;
 
+/*
+ * Number of times that the client runs. The runs after the first one show
+ * the resumption of the TLS session, as when the client reconnects to the
+ * server.
+ */
+static unsigned long runs = 2;
+
+#if !defined(__MBED__)
+/* Connect to a LocalServer instead of SERVER_ADDR */
+static bool loopback = false;
+
+/* Trace file to record the network activity to, or NULL */
+static const char *record_path = NULL;
+
+/* Trace file to replay the network activity from, or NULL */
+static const char *replay_path = NULL;
+
+/* Sleep for the recorded waits when replaying */
+static bool replay_delays = false;
+
+/* Lifetime (in seconds) of the TLS sessions that the client resumes */
+static unsigned long session_timeout = SESSION_CACHE_TIMEOUT;
+
+/* Time (in milliseconds) to wait before each run after the first one */
+static unsigned long pause_ms = 0;
+
+static void usage(const char *name)
+{
+    mbedtls_printf("usage: %s [--loopback] [--record=FILE] "
+                   "[--replay=FILE [--delays]]\n"
+                   "       [--runs=N] [--pause=MS] [--session-timeout=S]\n\n"
+                   "  --loopback      connect to a server in this program "
+                   "instead of %s\n"
+                   "  --record=FILE   write how the data arrived from the "
+                   "server to FILE\n"
+                   "  --replay=FILE   deliver the data in the pieces "
+                   "recorded in FILE\n"
+                   "  --delays        also wait as long as recorded in the "
+                   "replayed FILE\n"
+                   "  --runs=N        run the client N times (default: "
+                   "%lu)\n"
+                   "  --pause=MS      wait MS milliseconds between the "
+                   "runs\n"
+                   "  --session-timeout=S\n"
+                   "                  resume a TLS session for at most S "
+                   "seconds (default: %lu)\n",
+                   name, SERVER_ADDR, runs, session_timeout);
+}
+
+/*
+ * Parse the unsigned decimal number of an option, without a sign and without
+ * overflowing
+ */
+static int parse_number(const char *str, unsigned long *value)
+{
+    char *end;
+
+    errno = 0;
+    if (*str < '0' || *str > '9')
+        return -1;
+    *value = strtoul(str, &end, 10);
+    if (*end != '\0' || errno == ERANGE)
+        return -1;
+
+    return 0;
+}
+
+/*
+ * On the host the options are given on the command line
+ */
+static int parse_options(int argc, char *argv[])
+{
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--loopback") == 0) {
+            loopback = true;
+        } else if (strncmp(argv[i], "--record=", 9) == 0) {
+            record_path = argv[i] + 9;
+        } else if (strncmp(argv[i], "--replay=", 9) == 0) {
+            replay_path = argv[i] + 9;
+        } else if (strcmp(argv[i], "--delays") == 0) {
+            replay_delays = true;
+        } else if (strncmp(argv[i], "--runs=", 7) == 0) {
+            if (parse_number(argv[i] + 7, &runs) != 0 || runs == 0) {
+                mbedtls_printf("Invalid number \"%s\"\n", argv[i] + 7);
+                return -1;
+            }
+        } else if (strncmp(argv[i], "--pause=", 8) == 0) {
+            if (parse_number(argv[i] + 8, &pause_ms) != 0 ||
+                pause_ms > UINT32_MAX) {
+                mbedtls_printf("Invalid number \"%s\"\n", argv[i] + 8);
+                return -1;
+            }
+        } else if (strncmp(argv[i], "--session-timeout=", 18) == 0) {
+            if (parse_number(argv[i] + 18, &session_timeout) != 0 ||
+                session_timeout > UINT32_MAX) {
+                mbedtls_printf("Invalid number \"%s\"\n", argv[i] + 18);
+                return -1;
+            }
+        } else {
+            usage(argv[0]);
+            return -1;
+        }
+    }
+
+    if (record_path != NULL && replay_path != NULL) {
+        mbedtls_printf("--record and --replay cannot be used together\n");
+        return -1;
+    }
+
+    return 0;
+}
+#endif /* !__MBED__ */
+
 /**
  * The main function driving the HTTPS client.
  */
+#if defined(__MBED__)
 int main()
+#else
+int main(int argc, char *argv[])
+#endif /* __MBED__ */
 {
     int exit_code = MBEDTLS_EXIT_FAILURE;
+    int ret = 0;
+    unsigned long run;
+    const char *server_name = SERVER_NAME;
+    const char *server_addr = SERVER_ADDR;
+    Transport *transport;
+    TcpTransport *tcp = NULL;
+    HelloHttpsClient *client = NULL;
+    Timer timer;
+#if !defined(__MBED__)
+    LocalServer *server = NULL;
+    Transport *trace_transport = NULL;
+    FILE *trace = NULL;
+
+    if (parse_options(argc, argv) != 0)
+        return MBEDTLS_EXIT_FAILURE;
+#endif /* !__MBED__ */
 
     if((exit_code = mbedtls_platform_setup(NULL)) != 0) {
         printf("Platform initialization failed with error %d\r\n", exit_code);
         return MBEDTLS_EXIT_FAILURE;
     }
+    exit_code = MBEDTLS_EXIT_FAILURE;
 
 #if defined(MBEDTLS_USE_PSA_CRYPTO)
     /*
@@ -83,8 +232,6 @@ int main()
      * cause the other party to time out.
      */
 
-    HelloHttpsClient *client;
-
     mbedtls_printf("Starting mbed-os-example-tls/tls-client\n");
 
 #if defined(MBED_MAJOR_VERSION)
@@ -94,25 +241,97 @@ int main()
     printf("Using Mbed OS from master.\n");
 #endif /* MBEDTLS_MAJOR_VERSION */
 
-    /* Allocate a HTTPS client */
-    client = new (std::nothrow) HelloHttpsClient(SERVER_NAME, SERVER_ADDR, SERVER_PORT);
+    /* Allocate the transport to the server */
+    tcp = new (std::nothrow) TcpTransport(HELLO_HTTPS_CLIENT_IO_TIMEOUT_MS);
+    if (tcp == NULL) {
+        mbedtls_printf("Failed to allocate TcpTransport object\n");
+        goto exit;
+    }
+    transport = tcp;
 
+#if !defined(__MBED__)
+    if (loopback) {
+        server = new (std::nothrow) LocalServer();
+        if (server == NULL) {
+            mbedtls_printf("Failed to allocate LocalServer object\n");
+            goto exit;
+        }
+        if (server->setup() != 0)
+            goto exit;
+        transport = server->transport();
+        server_name = server_addr = "localhost";
+        mbedtls_printf("Using a local server instead of %s\n", SERVER_ADDR);
+    }
+
+    if (record_path != NULL || replay_path != NULL) {
+        trace = fopen(record_path != NULL ? record_path : replay_path,
+                      record_path != NULL ? "w" : "r");
+        if (trace == NULL) {
+            mbedtls_printf("Failed to open %s\n", record_path != NULL ?
+                           record_path : replay_path);
+            goto exit;
+        }
+        mbedtls_printf("%s the network activity %s %s\n",
+                       record_path != NULL ? "Recording" : "Replaying",
+                       record_path != NULL ? "to" : "from",
+                       record_path != NULL ? record_path : replay_path);
+        if (record_path != NULL)
+            trace_transport = new (std::nothrow)
+                RecordTransport(transport, trace);
+        else
+            trace_transport = new (std::nothrow)
+                ReplayTransport(transport, trace, replay_delays);
+        if (trace_transport == NULL) {
+            mbedtls_printf("Failed to allocate the trace transport\n");
+            goto exit;
+        }
+        transport = trace_transport;
+    }
+#endif /* !__MBED__ */
+
+    /* Allocate a HTTPS client */
+    client = new (std::nothrow) HelloHttpsClient(server_name, server_addr,
+                                                 SERVER_PORT, transport);
     if (client == NULL) {
-        mbedtls_printf("Failed to allocate HelloHttpsClient object\n"
-                       "\nFAIL\n");
-        mbedtls_platform_teardown(NULL);
-        return exit_code;
+        mbedtls_printf("Failed to allocate HelloHttpsClient object\n");
+        goto exit;
     }
+#if !defined(__MBED__)
+    if (server != NULL)
+        client->addTrustedCa(LocalServer::CA_DER, LocalServer::CA_DER_LEN);
+    client->setSessionTimeout(session_timeout);
+#endif /* !__MBED__ */
 
-    /* Run the client */
-    if (client->run() != 0) {
-        mbedtls_printf("\nFAIL\n");
-    } else {
-        exit_code = MBEDTLS_EXIT_SUCCESS;
-        mbedtls_printf("\nDONE\n");
+    /* Run the client, resuming the TLS session after the first run */
+    for (run = 1; run <= runs; run++) {
+#if !defined(__MBED__)
+        if (run > 1 && pause_ms > 0)
+            ThisThread::sleep_for(pause_ms);
+#endif /* !__MBED__ */
+        timer.reset();
+        timer.start();
+        ret = client->run();
+        timer.stop();
+        if (ret != 0)
+            break;
+        mbedtls_printf("Run %lu completed in %d ms\n", run, timer.read_ms());
     }
+    if (ret == 0)
+        exit_code = MBEDTLS_EXIT_SUCCESS;
+
+exit:
+    mbedtls_printf(exit_code == MBEDTLS_EXIT_SUCCESS ? "\nDONE\n" :
+                   "\nFAIL\n");
 
+    /* The client closes the transport, so it is deleted first */
     delete client;
+#if !defined(__MBED__)
+    delete trace_transport;
+    if (trace != NULL)
+        fclose(trace);
+    delete server;
+#endif /* !__MBED__ */
+    delete tcp;
 
     mbedtls_platform_teardown(NULL);
     return exit_code;
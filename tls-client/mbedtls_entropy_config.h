@@ -17,11 +17,17 @@
  *  This file is part of Mbed TLS (https://tls.mbed.org)
  */
 
+/*
+ * Mbed OS disables the platform entropy source (MBEDTLS_NO_PLATFORM_ENTROPY),
+ * whereas the host build uses the one of the operating system.
+ */
 #if !defined(MBEDTLS_ENTROPY_HARDWARE_ALT) && \
-    !defined(MBEDTLS_ENTROPY_NV_SEED) && !defined(MBEDTLS_TEST_NULL_ENTROPY)
+    !defined(MBEDTLS_ENTROPY_NV_SEED) && \
+    !defined(MBEDTLS_TEST_NULL_ENTROPY) && \
+    defined(MBEDTLS_NO_PLATFORM_ENTROPY)
 #error "This hardware does not have an entropy source."
 #endif /* !MBEDTLS_ENTROPY_HARDWARE_ALT && !MBEDTLS_ENTROPY_NV_SEED &&
-        * !MBEDTLS_TEST_NULL_ENTROPY */
+        * !MBEDTLS_TEST_NULL_ENTROPY && MBEDTLS_NO_PLATFORM_ENTROPY */
 
 #if !defined(MBEDTLS_SHA1_C)
 #define MBEDTLS_SHA1_C
@@ -47,3 +53,30 @@
 //#define MBEDTLS_USE_PSA_CRYPTO
 
 #define MBEDTLS_MPI_WINDOW_SIZE     1
+
+/*
+ * The trusted CAs are embedded in DER format (see TLS_DER_CAS in
+ * HelloHttpsClient.cpp), so the PEM parser is not needed.
+ */
+#undef MBEDTLS_PEM_PARSE_C
+
+/*
+ * Restartable ECC lets the TLS handshake return to
+ * HelloHttpsClient::connect() in the middle of the ECDHE key exchange and of
+ * the verification of ECDSA signatures, so that the other threads keep
+ * running. Mbed TLS only supports it with its own implementation of the
+ * elliptic curves, without PSA Crypto and without the legacy ECDH context of
+ * MBEDTLS_ECDH_LEGACY_CONTEXT.
+ */
+#if !defined(MBEDTLS_USE_PSA_CRYPTO) && \
+    !defined(MBEDTLS_ECP_ALT) && !defined(MBEDTLS_ECP_INTERNAL_ALT) && \
+    !defined(MBEDTLS_ECDH_GEN_PUBLIC_ALT) && \
+    !defined(MBEDTLS_ECDH_COMPUTE_SHARED_ALT) && \
+    !defined(MBEDTLS_ECDSA_SIGN_ALT) && !defined(MBEDTLS_ECDSA_VERIFY_ALT) && \
+    !defined(MBEDTLS_ECDSA_GENKEY_ALT)
+#define MBEDTLS_ECP_RESTARTABLE
+#undef MBEDTLS_ECDH_LEGACY_CONTEXT
+#endif /* !MBEDTLS_USE_PSA_CRYPTO && !MBEDTLS_ECP_ALT &&
+        * !MBEDTLS_ECP_INTERNAL_ALT && !MBEDTLS_ECDH_GEN_PUBLIC_ALT &&
+        * !MBEDTLS_ECDH_COMPUTE_SHARED_ALT && !MBEDTLS_ECDSA_SIGN_ALT &&
+        * !MBEDTLS_ECDSA_VERIFY_ALT && !MBEDTLS_ECDSA_GENKEY_ALT */